@@ -0,0 +1,35 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "AirControlSimCallback.h"
+#include "PhysicsProxy/SingleParticlePhysicsProxy.h"
+#include "Chaos/ParticleHandle.h"
+
+void FAirControlSimCallback::OnPreSimulate_Internal()
+{
+	if (const FAirControlAsyncInput* Input = GetConsumerInput_Internal())
+	{
+		Vehicles = Input->Vehicles;
+	}
+
+	const float DeltaTime = GetDeltaTime_Internal();
+	for (const FAirControlVehicleState& Vehicle : Vehicles)
+	{
+		Chaos::FRigidBodyHandle_Internal* Body = Vehicle.Proxy ? Vehicle.Proxy->GetPhysicsThreadAPI() : nullptr;
+		if (!Body || Body->ObjectState() != Chaos::EObjectStateType::Dynamic) continue;
+
+		Body->AddForce(CalculateForce(Body->R(), Vehicle));
+		// yaw as an acceleration so the mass of the vehicle does not matter
+		Body->SetW(Body->GetW() + FVector(0.0f, 0.0f, CalculateYawAcceleration(Vehicle) * DeltaTime));
+	}
+}
+
+FVector FAirControlSimCallback::CalculateForce(const FQuat& Rotation, const FAirControlVehicleState& Vehicle)
+{
+	// forward where the vehicle faces but only in the horizontal plane, plus a constant fall
+	FVector Forward = Rotation.GetForwardVector();
+	Forward.Z = 0.0f;
+	Forward = Forward.GetSafeNormal() * Vehicle.SpeedMultiplier;
+	const float Down = Vehicle.bParachuting ? ParachuteDownScale : 1.0f;
+	return Forward * ForwardForce + FVector(0.0f, 0.0f, -Down * DownForce);
+}
@@ -0,0 +1,60 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Chaos/SimCallbackObject.h"
+#include "Chaos/SimCallbackInput.h"
+
+namespace Chaos
+{
+	class FSingleParticlePhysicsProxy;
+}
+
+/** Air control state of one deployed vehicle, written on the game thread */
+struct FAirControlVehicleState
+{
+	Chaos::FSingleParticlePhysicsProxy* Proxy = nullptr;
+	float SpeedMultiplier = 1.0f;
+	float TurnMultiplier = 0.0f;
+	bool bParachuting = false;
+};
+
+struct FAirControlAsyncInput : public Chaos::FSimCallbackInput
+{
+	/** Every vehicle that is deployed right now, vehicles missing from the list get no air control */
+	TArray<FAirControlVehicleState> Vehicles;
+
+	void Reset()
+	{
+		Vehicles.Reset();
+	}
+};
+
+/**
+ *  Applies the air-drop and parachute forces on the physics thread
+ *  Runs before every physics step with that step's delta, so the forces do not depend on the game
+ *  frame rate. With async physics enabled (p.TickPhysicsAsync) the step is fixed.
+ */
+class FAirControlSimCallback : public Chaos::TSimCallbackObject<FAirControlAsyncInput>
+{
+public:
+	/** Horizontal push, scaled by the speed multiplier */
+	static constexpr float ForwardForce = 3000000.0f;
+	/** Downward push, scaled by ParachuteDownScale while the parachute is open */
+	static constexpr float DownForce = 3000000.0f;
+	static constexpr float ParachuteDownScale = 0.3f;
+	/** Yaw acceleration in rad/s^2 at full steering */
+	static constexpr float TurnAcceleration = 100.0f / 60.0f;
+
+	/** World space force on a deployed vehicle, shared with the kinematic deploy glide */
+	static FVector CalculateForce(const FQuat& Rotation, const FAirControlVehicleState& Vehicle);
+	/** Yaw acceleration in rad/s^2 */
+	static float CalculateYawAcceleration(const FAirControlVehicleState& Vehicle) { return TurnAcceleration * Vehicle.TurnMultiplier; }
+
+private:
+	virtual void OnPreSimulate_Internal() override;
+
+	/** Latest state received, reused for physics steps without a new game thread input */
+	TArray<FAirControlVehicleState> Vehicles;
+};
@@ -0,0 +1,67 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "CarDamageExecution.h"
+#include "CarAttributeSet.h"
+
+const FName UCarDamageExecution::DamageName(TEXT("Damage"));
+
+struct FCarDamageStatics
+{
+	DECLARE_ATTRIBUTE_CAPTUREDEF(Shield);
+	DECLARE_ATTRIBUTE_CAPTUREDEF(Health);
+
+	FCarDamageStatics()
+	{
+		// not snapshotted, the values at execution time are what the damage is taken from
+		DEFINE_ATTRIBUTE_CAPTUREDEF(UCarAttributeSet, Shield, Target, false);
+		DEFINE_ATTRIBUTE_CAPTUREDEF(UCarAttributeSet, Health, Target, false);
+	}
+};
+
+static const FCarDamageStatics& CarDamageStatics()
+{
+	static FCarDamageStatics Statics;
+	return Statics;
+}
+
+UCarDamageExecution::UCarDamageExecution()
+{
+	RelevantAttributesToCapture.Add(CarDamageStatics().ShieldDef);
+	RelevantAttributesToCapture.Add(CarDamageStatics().HealthDef);
+}
+
+void UCarDamageExecution::Execute_Implementation(const FGameplayEffectCustomExecutionParameters& ExecutionParams, FGameplayEffectCustomExecutionOutput& OutExecutionOutput) const
+{
+	const FGameplayEffectSpec& Spec = ExecutionParams.GetOwningSpec();
+	const float Damage = FMath::Max(0.0f, Spec.GetSetByCallerMagnitude(DamageName, false, 0.0f));
+	if (Damage <= 0.0f) return;
+
+	FAggregatorEvaluateParameters EvaluateParameters;
+	EvaluateParameters.SourceTags = Spec.CapturedSourceTags.GetAggregatedTags();
+	EvaluateParameters.TargetTags = Spec.CapturedTargetTags.GetAggregatedTags();
+
+	float Shield = 0.0f;
+	float Health = 0.0f;
+	ExecutionParams.AttemptCalculateCapturedAttributeMagnitude(CarDamageStatics().ShieldDef, EvaluateParameters, Shield);
+	ExecutionParams.AttemptCalculateCapturedAttributeMagnitude(CarDamageStatics().HealthDef, EvaluateParameters, Health);
+
+	const float ShieldDamage = FMath::Min(FMath::Max(Shield, 0.0f), Damage);
+	const float HealthDamage = FMath::Min(FMath::Max(Health, 0.0f), Damage - ShieldDamage);
+	if (ShieldDamage > 0.0f)
+	{
+		OutExecutionOutput.AddOutputModifier(FGameplayModifierEvaluatedData(CarDamageStatics().ShieldProperty, EGameplayModOp::Additive, -ShieldDamage));
+	}
+	if (HealthDamage > 0.0f)
+	{
+		OutExecutionOutput.AddOutputModifier(FGameplayModifierEvaluatedData(CarDamageStatics().HealthProperty, EGameplayModOp::Additive, -HealthDamage));
+	}
+}
+
+UCarDamageEffect::UCarDamageEffect()
+{
+	DurationPolicy = EGameplayEffectDurationType::Instant;
+	FGameplayEffectExecutionDefinition Execution;
+	Execution.CalculationClass = UCarDamageExecution::StaticClass();
+	Executions.Add(Execution);
+}
@@ -0,0 +1,42 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "GameplayEffectExecutionCalculation.h"
+#include "GameplayEffect.h"
+#include "CarDamageExecution.generated.h"
+
+/**
+ *  Resolves a damage amount against the target's UCarAttributeSet in one execution
+ *  The set by caller magnitude named DamageName is taken from Shield first, the rest from Health.
+ *  Health never goes below zero, overkill is dropped so the death callback runs once.
+ */
+UCLASS()
+class URBANCARNAGE_API UCarDamageExecution : public UGameplayEffectExecutionCalculation
+{
+	GENERATED_BODY()
+
+public:
+	UCarDamageExecution();
+
+	// Begin UGameplayEffectExecutionCalculation interface
+	virtual void Execute_Implementation(const FGameplayEffectCustomExecutionParameters& ExecutionParams, FGameplayEffectCustomExecutionOutput& OutExecutionOutput) const override;
+	// End UGameplayEffectExecutionCalculation interface
+
+	/** Set by caller name of the damage amount */
+	static const FName DamageName;
+};
+
+/**
+ *  Instant effect that runs UCarDamageExecution, the default of UDamageAggregatorSubsystem
+ *  Blueprint effects that add cues or tags should derive from it or add the execution themselves.
+ */
+UCLASS()
+class URBANCARNAGE_API UCarDamageEffect : public UGameplayEffect
+{
+	GENERATED_BODY()
+
+public:
+	UCarDamageEffect();
+};
@@ -0,0 +1,215 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "CosmeticEventSubsystem.h"
+#include "UrbanCarnagePawn.h"
+#include "UrbanCarnagePlayerController.h"
+#include "WeaponBase.h"
+#include "Engine/World.h"
+#include "Engine/NetConnection.h"
+#include "HAL/IConsoleManager.h"
+
+DECLARE_STATS_GROUP(TEXT("CosmeticEvents"), STATGROUP_CosmeticEvents, STATCAT_Advanced);
+DECLARE_CYCLE_STAT(TEXT("Cosmetic Events Tick"), STAT_CosmeticEventsTick, STATGROUP_CosmeticEvents);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Events Queued"), STAT_CosmeticEventsQueued, STATGROUP_CosmeticEvents);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Events Culled"), STAT_CosmeticEventsCulled, STATGROUP_CosmeticEvents);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Events Dropped"), STAT_CosmeticEventsDropped, STATGROUP_CosmeticEvents);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Events Sent"), STAT_CosmeticEventsSent, STATGROUP_CosmeticEvents);
+
+static TAutoConsoleVariable<float> CVarCosmeticFlushRate(
+	TEXT("UrbanCarnage.Cosmetic.FlushRate"),
+	20.0f,
+	TEXT("Times per second each connection's cosmetic events are sent."));
+
+static TAutoConsoleVariable<float> CVarCosmeticCullDistance(
+	TEXT("UrbanCarnage.Cosmetic.CullDistance"),
+	50000.0f,
+	TEXT("Players further than this from an event do not receive it."));
+
+static TAutoConsoleVariable<float> CVarCosmeticLowPriorityCullDistance(
+	TEXT("UrbanCarnage.Cosmetic.LowPriorityCullDistance"),
+	15000.0f,
+	TEXT("Cull distance of low priority events like weapon effects."));
+
+static TAutoConsoleVariable<int32> CVarCosmeticMaxEventsPerFlush(
+	TEXT("UrbanCarnage.Cosmetic.MaxEventsPerFlush"),
+	16,
+	TEXT("Budget of events in one client RPC, low priority events over it are dropped and the rest waits for the next flush."));
+
+bool UCosmeticEventSubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+	return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+void UCosmeticEventSubsystem::Deinitialize()
+{
+	Queues.Empty();
+	Super::Deinitialize();
+}
+
+TStatId UCosmeticEventSubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UCosmeticEventSubsystem, STATGROUP_CosmeticEvents);
+}
+
+void UCosmeticEventSubsystem::Post(AActor* Source, ECosmeticEventType Type, uint8 Param)
+{
+	if (!Source || !Source->HasAuthority()) return;
+	UWorld* World = Source->GetWorld();
+	const ENetMode NetMode = World->GetNetMode();
+	FCosmeticEvent Event;
+	Event.Source = Source;
+	Event.Type = Type;
+	Event.Param = Param;
+	if (NetMode != NM_DedicatedServer)
+	{
+		PlayEvent(Event);
+	}
+	if (NetMode == NM_Standalone) return;
+	if (UCosmeticEventSubsystem* Cosmetics = World->GetSubsystem<UCosmeticEventSubsystem>())
+	{
+		Cosmetics->QueueEvent(Event);
+	}
+}
+
+void UCosmeticEventSubsystem::PlayEvent(const FCosmeticEvent& Event)
+{
+	if (AUrbanCarnagePawn* Vehicle = Cast<AUrbanCarnagePawn>(Event.Source))
+	{
+		switch (Event.Type)
+		{
+		case ECosmeticEventType::DeployStart:
+			Vehicle->deployEffect_BP();
+			break;
+		case ECosmeticEventType::DeployStop:
+			Vehicle->StopDeployEffect_BP();
+			break;
+		case ECosmeticEventType::ParachuteOpen:
+			Vehicle->OpenParachutEffect_BP();
+			break;
+		case ECosmeticEventType::ParachuteStop:
+			Vehicle->StopParachutEffect_BP();
+			break;
+		case ECosmeticEventType::Destroyed:
+			Vehicle->DestroyEffect_BP();
+			break;
+		case ECosmeticEventType::WeaponFired:
+			if (AWeaponBase* Weapon = Vehicle->GetWeaponInSlot(Event.Param))
+			{
+				Weapon->PlayEffectBP();
+			}
+			break;
+		}
+	}
+}
+
+void UCosmeticEventSubsystem::QueueEvent(const FCosmeticEvent& Event)
+{
+	AActor* Source = Event.Source;
+	const bool bLowPriority = IsLowPriority(Event.Type);
+	const float CullDistance = bLowPriority ? CVarCosmeticLowPriorityCullDistance.GetValueOnGameThread() : CVarCosmeticCullDistance.GetValueOnGameThread();
+	const FVector Location = Source->GetActorLocation();
+
+	for (FConstPlayerControllerIterator It = GetWorld()->GetPlayerControllerIterator(); It; ++It)
+	{
+		AUrbanCarnagePlayerController* PlayerController = Cast<AUrbanCarnagePlayerController>(It->Get());
+		if (!PlayerController || PlayerController->IsLocalController()) continue;
+		UNetConnection* Connection = PlayerController->GetNetConnection();
+		// without a channel the source is not relevant to this player and the reference would not resolve either
+		if (!Connection || !Connection->FindActorChannelRef(TWeakObjectPtr<AActor>(Source)))
+		{
+			INC_DWORD_STAT(STAT_CosmeticEventsCulled);
+			continue;
+		}
+		// the owner played its weapon effects when it predicted the shots
+		if (Event.Type == ECosmeticEventType::WeaponFired && Source == PlayerController->GetPawn()) continue;
+
+		FVector ViewLocation;
+		FRotator ViewRotation;
+		PlayerController->GetPlayerViewPoint(ViewLocation, ViewRotation);
+		if (FVector::DistSquared(ViewLocation, Location) > FMath::Square(CullDistance))
+		{
+			INC_DWORD_STAT(STAT_CosmeticEventsCulled);
+			continue;
+		}
+
+		FConnectionQueue& Queue = Queues.FindOrAdd(PlayerController);
+		if (bLowPriority && Queue.Events.ContainsByPredicate([Source, &Event](const FQueuedCosmeticEvent& Queued)
+			{
+				return Queued.Source == Source && Queued.Type == Event.Type && Queued.Param == Event.Param;
+			}))
+		{
+			continue;
+		}
+		Queue.Events.Add({ Source, Event.Type, Event.Param });
+		INC_DWORD_STAT(STAT_CosmeticEventsQueued);
+	}
+}
+
+void UCosmeticEventSubsystem::Tick(float DeltaTime)
+{
+	SCOPE_CYCLE_COUNTER(STAT_CosmeticEventsTick);
+	if (Queues.Num() == 0) return;
+
+	const double Now = GetWorld()->GetTimeSeconds();
+	const double FlushInterval = 1.0 / FMath::Max(1.0f, CVarCosmeticFlushRate.GetValueOnGameThread());
+	for (auto It = Queues.CreateIterator(); It; ++It)
+	{
+		AUrbanCarnagePlayerController* PlayerController = It->Key.Get();
+		if (!PlayerController)
+		{
+			It.RemoveCurrent();
+			continue;
+		}
+		FConnectionQueue& Queue = It->Value;
+		if (Queue.Events.Num() == 0 || Now < Queue.NextFlushTime) continue;
+		FlushConnection(PlayerController, Queue.Events);
+		Queue.NextFlushTime = Now + FlushInterval;
+	}
+}
+
+void UCosmeticEventSubsystem::FlushConnection(AUrbanCarnagePlayerController* PlayerController, TArray<FQueuedCosmeticEvent>& Events)
+{
+	UNetConnection* Connection = PlayerController->GetNetConnection();
+	if (!Connection)
+	{
+		Events.Reset();
+		return;
+	}
+	// sources destroyed since the event was queued have nothing left to play it on
+	Events.RemoveAll([](const FQueuedCosmeticEvent& Event) { return !Event.Source.IsValid(); });
+
+	// over budget or saturated, low priority events go first, the oldest first
+	const int32 MaxEvents = FMath::Max(1, CVarCosmeticMaxEventsPerFlush.GetValueOnGameThread());
+	const bool bSaturated = !Connection->IsNetReady(false);
+	int32 NumToDrop = bSaturated ? Events.Num() : Events.Num() - MaxEvents;
+	for (int32 Index = 0; Index < Events.Num() && NumToDrop > 0;)
+	{
+		if (IsLowPriority(Events[Index].Type))
+		{
+			Events.RemoveAt(Index, 1, EAllowShrinking::No);
+			INC_DWORD_STAT(STAT_CosmeticEventsDropped);
+			--NumToDrop;
+		}
+		else
+		{
+			++Index;
+		}
+	}
+	// the rest is high priority, it waits for the connection or the next flush
+	if (bSaturated || Events.Num() == 0) return;
+
+	const int32 NumToSend = FMath::Min(Events.Num(), MaxEvents);
+	INC_DWORD_STAT_BY(STAT_CosmeticEventsSent, NumToSend);
+	TArray<FCosmeticEvent> SendEvents;
+	SendEvents.Reserve(NumToSend);
+	for (int32 Index = 0; Index < NumToSend; ++Index)
+	{
+		FCosmeticEvent& Event = SendEvents.AddDefaulted_GetRef();
+		Event.Source = Events[Index].Source.Get();
+		Event.Type = Events[Index].Type;
+		Event.Param = Events[Index].Param;
+	}
+	PlayerController->Client_CosmeticEvents(SendEvents);
+	Events.RemoveAt(0, NumToSend, EAllowShrinking::No);
+}
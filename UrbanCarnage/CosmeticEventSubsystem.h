@@ -0,0 +1,63 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "UrbanCarnageNetTypes.h"
+#include "CosmeticEventSubsystem.generated.h"
+
+class AUrbanCarnagePlayerController;
+
+/**
+ *  Server side channel for the cosmetic effects of vehicles and weapons
+ *  Events are culled per connection when they are queued: too far from the player's view point, or the
+ *  source actor has no open channel on the connection. Each connection's queue goes out as one unreliable
+ *  client RPC at UrbanCarnage.Cosmetic.FlushRate. Repeated weapon effects of the same source collapse into
+ *  one, and low priority events are dropped when the queue is over budget or the connection is saturated.
+ *  Local players on a listen server or in standalone play the events right away.
+ */
+UCLASS()
+class URBANCARNAGE_API UCosmeticEventSubsystem : public UTickableWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	// Begin USubsystem interface
+	virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+	virtual void Deinitialize() override;
+	// End USubsystem interface
+
+	// Begin FTickableGameObject interface
+	virtual void Tick(float DeltaTime) override;
+	virtual TStatId GetStatId() const override;
+	// End FTickableGameObject interface
+
+	/** Server side, plays Type on Source for every player that can see it, does nothing on clients */
+	static void Post(AActor* Source, ECosmeticEventType Type, uint8 Param = 0);
+
+	/** Plays an event on this machine */
+	static void PlayEvent(const FCosmeticEvent& Event);
+
+protected:
+	void QueueEvent(const FCosmeticEvent& Event);
+	static bool IsLowPriority(ECosmeticEventType Type) { return Type == ECosmeticEventType::WeaponFired; }
+
+	/** A queued event, the source is only weakly held while the event waits for its connection */
+	struct FQueuedCosmeticEvent
+	{
+		TWeakObjectPtr<AActor> Source;
+		ECosmeticEventType Type = ECosmeticEventType::DeployStart;
+		uint8 Param = 0;
+	};
+
+	void FlushConnection(AUrbanCarnagePlayerController* PlayerController, TArray<FQueuedCosmeticEvent>& Events);
+
+	struct FConnectionQueue
+	{
+		TArray<FQueuedCosmeticEvent> Events;
+		double NextFlushTime = 0.0;
+	};
+
+	TMap<TWeakObjectPtr<AUrbanCarnagePlayerController>, FConnectionQueue> Queues;
+};
@@ -0,0 +1,180 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "DamageAggregatorSubsystem.h"
+#include "CarDamageExecution.h"
+#include "WeaponBase.h"
+#include "AbilitySystemBlueprintLibrary.h"
+#include "AbilitySystemComponent.h"
+#include "GameplayEffect.h"
+#include "Engine/World.h"
+#include "HAL/IConsoleManager.h"
+
+DEFINE_LOG_CATEGORY_STATIC(LogDamageAggregator, Log, All);
+
+DECLARE_STATS_GROUP(TEXT("Damage"), STATGROUP_Damage, STATCAT_Advanced);
+DECLARE_CYCLE_STAT(TEXT("Apply Aggregated Damage"), STAT_DamageApply, STATGROUP_Damage);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Damage Hits"), STAT_DamageHits, STATGROUP_Damage);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Damage Effects"), STAT_DamageEffects, STATGROUP_Damage);
+
+static TAutoConsoleVariable<bool> CVarDamageAggregate(
+	TEXT("UrbanCarnage.Damage.Aggregate"),
+	true,
+	TEXT("If true, hits are summed per target and applied once at the end of the frame, otherwise every hit applies its weapon's effect."));
+
+bool UDamageAggregatorSubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+	return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+void UDamageAggregatorSubsystem::Initialize(FSubsystemCollectionBase& Collection)
+{
+	Super::Initialize(Collection);
+	DamageEffectClass = DamageEffect.LoadSynchronous();
+	if (!DamageEffectClass)
+	{
+		if (!DamageEffect.IsNull())
+		{
+			UE_LOG(LogDamageAggregator, Warning, TEXT("Failed to load damage effect %s, using UCarDamageEffect"), *DamageEffect.ToString());
+		}
+		DamageEffectClass = UCarDamageEffect::StaticClass();
+	}
+	// after every actor and tickable subsystem of the frame queued its hits
+	PostActorTickHandle = FWorldDelegates::OnWorldPostActorTick.AddUObject(this, &UDamageAggregatorSubsystem::OnWorldPostActorTick);
+}
+
+void UDamageAggregatorSubsystem::Deinitialize()
+{
+	FWorldDelegates::OnWorldPostActorTick.Remove(PostActorTickHandle);
+	PendingDamage.Empty();
+	Ledgers.Empty();
+	Super::Deinitialize();
+}
+
+void UDamageAggregatorSubsystem::AddDamage(AActor* Target, AWeaponBase* Weapon, float Amount)
+{
+	if (!Target || !Weapon || Amount <= 0.0f) return;
+	INC_DWORD_STAT(STAT_DamageHits);
+	if (!CVarDamageAggregate.GetValueOnGameThread())
+	{
+		Weapon->ApplyDamageEffect(Target, Amount);
+		return;
+	}
+
+	FPendingDamage& Pending = PendingDamage.FindOrAdd(Target);
+	Pending.Damage += Amount;
+	AActor* Instigator = Weapon->GetOwner();
+	FInstigatorDamage* Entry = Pending.Instigators.FindByPredicate([Instigator](const FInstigatorDamage& Existing) { return Existing.Instigator == Instigator; });
+	if (!Entry)
+	{
+		Entry = &Pending.Instigators.AddDefaulted_GetRef();
+		Entry->Instigator = Instigator;
+	}
+	Entry->Weapon = Weapon;
+	Entry->Damage += Amount;
+}
+
+void UDamageAggregatorSubsystem::OnWorldPostActorTick(UWorld* InWorld, ELevelTick TickType, float DeltaSeconds)
+{
+	if (InWorld == GetWorld())
+	{
+		ApplyPendingDamage();
+	}
+}
+
+void UDamageAggregatorSubsystem::ApplyPendingDamage()
+{
+	if (PendingDamage.Num() == 0) return;
+	SCOPE_CYCLE_COUNTER(STAT_DamageApply);
+
+	// applying can kill a vehicle and queue more damage from its death, work on this frame's batch only
+	TMap<TWeakObjectPtr<AActor>, FPendingDamage> Batch = MoveTemp(PendingDamage);
+	PendingDamage.Reset();
+	for (const TPair<TWeakObjectPtr<AActor>, FPendingDamage>& Pair : Batch)
+	{
+		AActor* Target = Pair.Key.Get();
+		const FPendingDamage& Pending = Pair.Value;
+		if (!Target || Pending.Instigators.Num() == 0) continue;
+
+		// the biggest share of the frame instigates the effect and takes the kill if it is lethal
+		const FInstigatorDamage* Top = &Pending.Instigators[0];
+		for (const FInstigatorDamage& Entry : Pending.Instigators)
+		{
+			if (Entry.Damage > Top->Damage)
+			{
+				Top = &Entry;
+			}
+		}
+		RecordDamage(Target, Pending, *Top);
+
+		UAbilitySystemComponent* TargetASC = UAbilitySystemBlueprintLibrary::GetAbilitySystemComponent(Target);
+		if (!TargetASC) continue;
+		AActor* Instigator = Top->Instigator.Get();
+		UAbilitySystemComponent* SourceASC = UAbilitySystemBlueprintLibrary::GetAbilitySystemComponent(Instigator);
+		UAbilitySystemComponent* SpecASC = SourceASC ? SourceASC : TargetASC;
+		FGameplayEffectContextHandle Context = SpecASC->MakeEffectContext();
+		Context.AddInstigator(Instigator, Top->Weapon.Get());
+		FGameplayEffectSpecHandle Spec = SpecASC->MakeOutgoingSpec(DamageEffectClass, 1.0f, Context);
+		if (!Spec.IsValid()) continue;
+		Spec.Data->SetSetByCallerMagnitude(UCarDamageExecution::DamageName, Pending.Damage);
+		INC_DWORD_STAT(STAT_DamageEffects);
+		SpecASC->ApplyGameplayEffectSpecToTarget(*Spec.Data.Get(), TargetASC);
+	}
+
+	// forget targets that went away
+	for (auto It = Ledgers.CreateIterator(); It; ++It)
+	{
+		if (!It->Key.IsValid())
+		{
+			It.RemoveCurrent();
+		}
+	}
+}
+
+void UDamageAggregatorSubsystem::RecordDamage(AActor* Target, const FPendingDamage& Pending, const FInstigatorDamage& Top)
+{
+	const double Now = GetWorld()->GetTimeSeconds();
+	FDamageLedger& Ledger = Ledgers.FindOrAdd(Target);
+	Ledger.KillCredit = Top.Instigator;
+	Ledger.Records.RemoveAll([this, Now](const FDamageRecord& Record) { return !Record.Instigator.IsValid() || Now - Record.LastTime > AssistWindow; });
+	for (const FInstigatorDamage& Entry : Pending.Instigators)
+	{
+		FDamageRecord* Record = Ledger.Records.FindByPredicate([&Entry](const FDamageRecord& Existing) { return Existing.Instigator == Entry.Instigator; });
+		if (!Record)
+		{
+			Record = &Ledger.Records.AddDefaulted_GetRef();
+			Record->Instigator = Entry.Instigator;
+		}
+		Record->Damage += Entry.Damage;
+		Record->LastTime = Now;
+	}
+}
+
+AActor* UDamageAggregatorSubsystem::GetKillCredit(const AActor* Target) const
+{
+	const FDamageLedger* Ledger = Ledgers.Find(Target);
+	return Ledger ? Ledger->KillCredit.Get() : nullptr;
+}
+
+TArray<AActor*> UDamageAggregatorSubsystem::GetDamageInstigators(const AActor* Target) const
+{
+	TArray<AActor*> Instigators;
+	const FDamageLedger* Ledger = Ledgers.Find(Target);
+	if (!Ledger) return Instigators;
+
+	const double Now = GetWorld()->GetTimeSeconds();
+	TArray<const FDamageRecord*, TInlineAllocator<4>> Records;
+	for (const FDamageRecord& Record : Ledger->Records)
+	{
+		if (Record.Instigator.IsValid() && Now - Record.LastTime <= AssistWindow)
+		{
+			Records.Add(&Record);
+		}
+	}
+	Records.Sort([](const FDamageRecord& A, const FDamageRecord& B) { return A.Damage > B.Damage; });
+	for (const FDamageRecord* Record : Records)
+	{
+		Instigators.Add(Record->Instigator.Get());
+	}
+	return Instigators;
+}
@@ -0,0 +1,95 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "Engine/EngineBaseTypes.h"
+#include "DamageAggregatorSubsystem.generated.h"
+
+class AWeaponBase;
+class UGameplayEffect;
+
+/**
+ *  Server side accumulator that turns all hits on a target within a frame into one gameplay effect
+ *  Weapons queue their hits through AddDamage. After the actors ticked the damage of each target is summed
+ *  and applied once with DamageEffect, whose UCarDamageExecution takes it from Shield then Health, so the
+ *  attribute set sees one execution and one replicated change per target and frame.
+ *  Who dealt how much is kept per target for kill credit and assists.
+ *
+ *  DamageEffect defaults to the native UCarDamageEffect, a Blueprint effect can be set in DefaultGame.ini:
+ *  [/Script/UrbanCarnage.DamageAggregatorSubsystem]
+ *  DamageEffect=/Game/GAS/GE_AggregatedDamage.GE_AggregatedDamage_C
+ */
+UCLASS(Config = Game)
+class URBANCARNAGE_API UDamageAggregatorSubsystem : public UWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	// Begin USubsystem interface
+	virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+	virtual void Initialize(FSubsystemCollectionBase& Collection) override;
+	virtual void Deinitialize() override;
+	// End USubsystem interface
+
+	/** Adds a hit of Weapon to the damage Target takes at the end of this frame */
+	void AddDamage(AActor* Target, AWeaponBase* Weapon, float Amount);
+
+	/** Vehicle that dealt the most damage in the last frame Target was damaged, the killer if that frame was lethal */
+	UFUNCTION(BlueprintCallable, Category = "Damage")
+	AActor* GetKillCredit(const AActor* Target) const;
+
+	/** Every vehicle that damaged Target within AssistWindow, most damage first */
+	UFUNCTION(BlueprintCallable, Category = "Damage")
+	TArray<AActor*> GetDamageInstigators(const AActor* Target) const;
+
+	/** Instant effect applied once per damaged target and frame, should execute UCarDamageExecution. UCarDamageEffect if unset */
+	UPROPERTY(Config)
+	TSoftClassPtr<UGameplayEffect> DamageEffect;
+
+	/** Seconds a vehicle's damage on a target counts towards an assist */
+	UPROPERTY(Config)
+	float AssistWindow = 10.0f;
+
+protected:
+	struct FInstigatorDamage
+	{
+		TWeakObjectPtr<AActor> Instigator;
+		TWeakObjectPtr<AWeaponBase> Weapon;
+		float Damage = 0.0f;
+	};
+
+	struct FPendingDamage
+	{
+		TArray<FInstigatorDamage, TInlineAllocator<4>> Instigators;
+		float Damage = 0.0f;
+	};
+
+	struct FDamageRecord
+	{
+		TWeakObjectPtr<AActor> Instigator;
+		float Damage = 0.0f;
+		double LastTime = 0.0;
+	};
+
+	struct FDamageLedger
+	{
+		TArray<FDamageRecord, TInlineAllocator<4>> Records;
+		TWeakObjectPtr<AActor> KillCredit;
+	};
+
+	void OnWorldPostActorTick(UWorld* InWorld, ELevelTick TickType, float DeltaSeconds);
+	void ApplyPendingDamage();
+	void RecordDamage(AActor* Target, const FPendingDamage& Pending, const FInstigatorDamage& Top);
+
+	/** Damage queued this frame per target */
+	TMap<TWeakObjectPtr<AActor>, FPendingDamage> PendingDamage;
+	/** Recent damage per target */
+	TMap<TWeakObjectPtr<const AActor>, FDamageLedger> Ledgers;
+
+	UPROPERTY(Transient)
+	TSubclassOf<UGameplayEffect> DamageEffectClass;
+
+	FDelegateHandle PostActorTickHandle;
+};
@@ -0,0 +1,160 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "FireSchedulerSubsystem.h"
+#include "WeaponBase.h"
+#include "UrbanCarnagePawn.h"
+#include "Engine/World.h"
+#include "HAL/IConsoleManager.h"
+
+DECLARE_STATS_GROUP(TEXT("FireScheduler"), STATGROUP_FireScheduler, STATCAT_Advanced);
+DECLARE_CYCLE_STAT(TEXT("Fire Scheduler Tick"), STAT_FireSchedulerTick, STATGROUP_FireScheduler);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Scheduled Weapons"), STAT_FireSchedulerWeapons, STATGROUP_FireScheduler);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Shots Fired"), STAT_FireSchedulerShots, STATGROUP_FireScheduler);
+
+static TAutoConsoleVariable<float> CVarFireTriggerHoldTime(
+	TEXT("UrbanCarnage.Fire.TriggerHoldTime"),
+	0.2f,
+	TEXT("Seconds a fire request keeps the trigger held, covers the gap between two fire RPCs."));
+
+static TAutoConsoleVariable<int32> CVarFireMaxShotsPerTick(
+	TEXT("UrbanCarnage.Fire.MaxShotsPerTick"),
+	32,
+	TEXT("Upper bound of shots one weapon fires in a single tick, the backlog is dropped after a hitch."));
+
+static TAutoConsoleVariable<float> CVarFirePredictionTolerance(
+	TEXT("UrbanCarnage.Fire.PredictionTolerance"),
+	0.1f,
+	TEXT("Seconds of shots a predicting client may be ahead of the server's cooldown, absorbs packets arriving in bursts."));
+
+bool UFireSchedulerSubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+	return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+void UFireSchedulerSubsystem::Deinitialize()
+{
+	Weapons.Empty();
+	Super::Deinitialize();
+}
+
+TStatId UFireSchedulerSubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UFireSchedulerSubsystem, STATGROUP_FireScheduler);
+}
+
+void UFireSchedulerSubsystem::RequestFire(AWeaponBase* Weapon)
+{
+	if (!Weapon) return;
+	const double Now = GetWorld()->GetTimeSeconds();
+	FScheduledWeapon* Entry = Weapons.FindByPredicate([Weapon](const FScheduledWeapon& Scheduled) { return Scheduled.Weapon == Weapon; });
+	if (!Entry)
+	{
+		// entries only go away once their cooldown is over, so a new one may fire right away
+		Entry = &Weapons.AddDefaulted_GetRef();
+		Entry->Weapon = Weapon;
+		Entry->NextFireTime = Now;
+	}
+	else if (Entry->HeldUntil < Now)
+	{
+		// the trigger was let go, idle time does not build up a backlog of shots
+		Entry->NextFireTime = FMath::Max(Entry->NextFireTime, Now);
+	}
+	Entry->HeldUntil = Now + CVarFireTriggerHoldTime.GetValueOnGameThread();
+}
+
+void UFireSchedulerSubsystem::ReleaseTrigger(AWeaponBase* Weapon)
+{
+	if (FScheduledWeapon* Entry = Weapons.FindByPredicate([Weapon](const FScheduledWeapon& Scheduled) { return Scheduled.Weapon == Weapon; }))
+	{
+		Entry->HeldUntil = 0.0;
+	}
+}
+
+bool UFireSchedulerSubsystem::ConsumePredictedShot(AWeaponBase* Weapon)
+{
+	const double Rate = Weapon ? (double)Weapon->FireRate * Weapon->FireRateMultiplier : 0.0;
+	if (Rate <= 0.0) return false;
+	const double Now = GetWorld()->GetTimeSeconds();
+	const double Tolerance = FMath::Max(0.0f, CVarFirePredictionTolerance.GetValueOnGameThread());
+	FScheduledWeapon* Entry = Weapons.FindByPredicate([Weapon](const FScheduledWeapon& Scheduled) { return Scheduled.Weapon == Weapon; });
+	if (!Entry)
+	{
+		Entry = &Weapons.AddDefaulted_GetRef();
+		Entry->Weapon = Weapon;
+		Entry->NextFireTime = Now;
+	}
+	if (Entry->NextFireTime > Now + Tolerance)
+	{
+		return false;
+	}
+	// idle time only builds up as much credit as the tolerance, the trigger stays released so Tick fires nothing
+	Entry->NextFireTime = FMath::Max(Entry->NextFireTime, Now - Tolerance) + 1.0 / Rate;
+	Entry->HeldUntil = 0.0;
+	return true;
+}
+
+void UFireSchedulerSubsystem::Tick(float DeltaTime)
+{
+	SCOPE_CYCLE_COUNTER(STAT_FireSchedulerTick);
+	SET_DWORD_STAT(STAT_FireSchedulerWeapons, Weapons.Num());
+	if (Weapons.Num() == 0) return;
+
+	const double Now = GetWorld()->GetTimeSeconds();
+	const int32 MaxShotsPerTick = FMath::Max(1, CVarFireMaxShotsPerTick.GetValueOnGameThread());
+	TArray<AUrbanCarnagePawn*, TInlineAllocator<8>> FiringPawns;
+
+	for (int32 Index = Weapons.Num() - 1; Index >= 0; --Index)
+	{
+		FScheduledWeapon& Entry = Weapons[Index];
+		AWeaponBase* Weapon = Entry.Weapon.Get();
+		const double Rate = Weapon ? (double)Weapon->FireRate * Weapon->FireRateMultiplier : 0.0;
+		if (!Weapon || Rate <= 0.0)
+		{
+			Weapons.RemoveAtSwap(Index, 1, EAllowShrinking::No);
+			continue;
+		}
+
+		// fire every shot that became due, the oldest first, the remainder carries over to the next tick
+		const double Interval = 1.0 / Rate;
+		const double FireUntil = FMath::Min(Now, Entry.HeldUntil);
+		int32 NumShots = 0;
+		bool bFired = false;
+		while (Entry.NextFireTime <= FireUntil && NumShots < MaxShotsPerTick)
+		{
+			bFired |= Weapon->FireShot((float)(Now - Entry.NextFireTime));
+			Entry.NextFireTime += Interval;
+			++NumShots;
+		}
+		if (NumShots == MaxShotsPerTick && Entry.NextFireTime <= FireUntil)
+		{
+			Entry.NextFireTime = Now + Interval;
+		}
+		INC_DWORD_STAT_BY(STAT_FireSchedulerShots, NumShots);
+
+		if (bFired)
+		{
+			// one cosmetic per batch for the local player, remote clients get the shots from the vehicle
+			if (Weapon->IsOwnerLocallyControlled())
+			{
+				Weapon->ShotFiredEffect();
+			}
+			if (AUrbanCarnagePawn* Pawn = Cast<AUrbanCarnagePawn>(Weapon->GetOwner()))
+			{
+				FiringPawns.AddUnique(Pawn);
+			}
+		}
+
+		// released and cooled down, nothing left to track
+		if (Entry.HeldUntil < Now && Entry.NextFireTime <= Now)
+		{
+			Weapons.RemoveAtSwap(Index, 1, EAllowShrinking::No);
+		}
+	}
+
+	// pawns ticked before us this frame, send the shot events now instead of a frame late
+	for (AUrbanCarnagePawn* Pawn : FiringPawns)
+	{
+		Pawn->FlushShotEvents();
+	}
+}
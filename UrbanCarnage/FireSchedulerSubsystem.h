@@ -0,0 +1,58 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "FireSchedulerSubsystem.generated.h"
+
+class AWeaponBase;
+
+/**
+ *  Fire rate scheduler for all weapons, on the server and on owning clients predicting their shots
+ *  Each weapon with a held trigger keeps the timestamp of its next allowed shot. Every tick all shots that
+ *  became due since the last tick are fired as one batch, each with its age inside the frame, so
+ *  FireRate x FireRateMultiplier is honored exactly regardless of the tick rate.
+ *  Shots predicted by clients do not go through the held trigger, the server checks them against the same
+ *  cooldown with ConsumePredictedShot.
+ */
+UCLASS()
+class URBANCARNAGE_API UFireSchedulerSubsystem : public UTickableWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	// Begin USubsystem interface
+	virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+	virtual void Deinitialize() override;
+	// End USubsystem interface
+
+	// Begin FTickableGameObject interface
+	virtual void Tick(float DeltaTime) override;
+	virtual TStatId GetStatId() const override;
+	// End FTickableGameObject interface
+
+	/** Marks the trigger of Weapon as held, it keeps firing until no request came in for the hold time */
+	void RequestFire(AWeaponBase* Weapon);
+
+	/** Releases the trigger of Weapon right away */
+	void ReleaseTrigger(AWeaponBase* Weapon);
+
+	/**
+	 * Server side, takes one shot a client predicted for Weapon out of its cooldown.
+	 * @return false if the shot came in faster than the fire rate allows, beyond the jitter tolerance
+	 */
+	bool ConsumePredictedShot(AWeaponBase* Weapon);
+
+protected:
+	struct FScheduledWeapon
+	{
+		TWeakObjectPtr<AWeaponBase> Weapon;
+		/** World time the next shot is allowed at */
+		double NextFireTime = 0.0;
+		/** World time the trigger counts as released at */
+		double HeldUntil = 0.0;
+	};
+
+	TArray<FScheduledWeapon> Weapons;
+};
@@ -0,0 +1,168 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "GroundQuerySubsystem.h"
+#include "UrbanCarnagePawn.h"
+#include "TerrainHeightSubsystem.h"
+#include "Engine/World.h"
+#include "HAL/IConsoleManager.h"
+
+DECLARE_STATS_GROUP(TEXT("GroundQuery"), STATGROUP_GroundQuery, STATCAT_Advanced);
+DECLARE_CYCLE_STAT(TEXT("Ground Query Update"), STAT_GroundQueryUpdate, STATGROUP_GroundQuery);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Ground Probes"), STAT_GroundQueryProbes, STATGROUP_GroundQuery);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Height Grid Queries"), STAT_GroundQueryGrid, STATGROUP_GroundQuery);
+
+static TAutoConsoleVariable<bool> CVarGroundQueryAsync(
+	TEXT("UrbanCarnage.GroundQuery.Async"),
+	true,
+	TEXT("If true, ground probes are async traces resolved on the next frame."));
+
+static TAutoConsoleVariable<float> CVarGroundQueryProbeDistance(
+	TEXT("UrbanCarnage.GroundQuery.ProbeDistance"),
+	200000.0f,
+	TEXT("Length of the downward ground probe, the ground height it finds schedules the next probe."));
+
+static TAutoConsoleVariable<float> CVarGroundQueryMaxInterval(
+	TEXT("UrbanCarnage.GroundQuery.MaxInterval"),
+	0.5f,
+	TEXT("Longest time between two ground probes of one vehicle, covers terrain rising under a gliding vehicle."));
+
+bool UGroundQuerySubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+	return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+void UGroundQuerySubsystem::Deinitialize()
+{
+	States.Empty();
+	Super::Deinitialize();
+}
+
+void UGroundQuerySubsystem::Update(TConstArrayView<AUrbanCarnagePawn*> AirborneVehicles)
+{
+	SCOPE_CYCLE_COUNTER(STAT_GroundQueryUpdate);
+	UWorld* World = GetWorld();
+	const double Now = World->GetTimeSeconds();
+	const bool bAsync = CVarGroundQueryAsync.GetValueOnGameThread();
+	const UTerrainHeightSubsystem* TerrainHeight = World->GetSubsystem<UTerrainHeightSubsystem>();
+
+	for (AUrbanCarnagePawn* Vehicle : AirborneVehicles)
+	{
+		FGroundQueryState& State = States.FindOrAdd(Vehicle);
+		State.LastUpdateFrame = GFrameCounter;
+
+		// the height grid answers without a trace unless dynamic geometry is close
+		float GroundHeight = 0.0f;
+		if (TerrainHeight && TerrainHeight->GetGroundHeight(Vehicle->GetActorLocation(), GroundHeight))
+		{
+			INC_DWORD_STAT(STAT_GroundQueryGrid);
+			State.bPending = false;
+			State.NextQueryTime = Now;
+			if (Vehicle->GetActorLocation().Z - GroundHeight <= Vehicle->GroundCheckDistance)
+			{
+				Vehicle->LandOnGround();
+			}
+			continue;
+		}
+
+		if (State.bPending)
+		{
+			FTraceDatum TraceData;
+			if (World->QueryTraceData(State.TraceHandle, TraceData))
+			{
+				State.bPending = false;
+				const FHitResult* Hit = TraceData.OutHits.FindByPredicate([](const FHitResult& Result) { return Result.bBlockingHit; });
+				HandleProbeResult(Vehicle, State, Hit);
+			}
+			else if (World->IsTraceHandleValid(State.TraceHandle, false))
+			{
+				continue;
+			}
+			else
+			{
+				// the result was dropped, probe again right away
+				State.bPending = false;
+				State.NextQueryTime = Now;
+			}
+		}
+
+		if (Vehicle->bIsInAir && !State.bPending && Now >= State.NextQueryTime)
+		{
+			IssueProbe(Vehicle, State, bAsync);
+		}
+	}
+
+	// forget vehicles that landed or went away
+	for (auto It = States.CreateIterator(); It; ++It)
+	{
+		if (It->Value.LastUpdateFrame != GFrameCounter || !It->Key.IsValid())
+		{
+			It.RemoveCurrent();
+		}
+	}
+}
+
+void UGroundQuerySubsystem::IssueProbe(AUrbanCarnagePawn* Vehicle, FGroundQueryState& State, bool bAsync)
+{
+	INC_DWORD_STAT(STAT_GroundQueryProbes);
+	UWorld* World = GetWorld();
+	const FVector Start = Vehicle->GetActorLocation();
+	const FVector End = Start - FVector(0.0f, 0.0f, CVarGroundQueryProbeDistance.GetValueOnGameThread());
+	FCollisionQueryParams QueryParams(SCENE_QUERY_STAT(GroundQuery), false, Vehicle);
+
+	if (bAsync)
+	{
+		State.TraceHandle = World->AsyncLineTraceByChannel(EAsyncTraceType::Single, Start, End, ECC_Visibility, QueryParams);
+		State.bPending = true;
+		return;
+	}
+	FHitResult Hit;
+	const bool bHit = World->LineTraceSingleByChannel(Hit, Start, End, ECC_Visibility, QueryParams);
+	HandleProbeResult(Vehicle, State, bHit ? &Hit : nullptr);
+}
+
+void UGroundQuerySubsystem::HandleProbeResult(AUrbanCarnagePawn* Vehicle, FGroundQueryState& State, const FHitResult* Hit)
+{
+	const double Now = GetWorld()->GetTimeSeconds();
+	const float MaxInterval = CVarGroundQueryMaxInterval.GetValueOnGameThread();
+	if (!Hit)
+	{
+		State.NextQueryTime = Now + MaxInterval;
+		return;
+	}
+
+	// measured from where the vehicle is now, it kept falling while the async probe was in flight
+	const float Height = Vehicle->GetActorLocation().Z - Hit->ImpactPoint.Z;
+	if (Height <= Vehicle->GroundCheckDistance)
+	{
+		Vehicle->LandOnGround();
+		return;
+	}
+
+	// probe again at half the time it takes to fall into the landing distance
+	const float FallSpeed = FMath::Max(0.0f, -(float)Vehicle->GetVelocity().Z);
+	const float Gap = Height - Vehicle->GroundCheckDistance;
+	const float Interval = FallSpeed > KINDA_SMALL_NUMBER ? 0.5f * Gap / FallSpeed : MaxInterval;
+	State.NextQueryTime = Now + FMath::Min(Interval, MaxInterval);
+}
+
+float UGroundQuerySubsystem::GetHeightAboveGround(const AActor* Actor) const
+{
+	if (!Actor) return -1.0f;
+	const FVector Location = Actor->GetActorLocation();
+	float GroundHeight = 0.0f;
+	const UTerrainHeightSubsystem* TerrainHeight = GetWorld()->GetSubsystem<UTerrainHeightSubsystem>();
+	if (TerrainHeight && TerrainHeight->GetGroundHeight(Location, GroundHeight))
+	{
+		return Location.Z - GroundHeight;
+	}
+
+	FHitResult Hit;
+	const FVector End = Location - FVector(0.0f, 0.0f, CVarGroundQueryProbeDistance.GetValueOnGameThread());
+	FCollisionQueryParams QueryParams(SCENE_QUERY_STAT(GroundQuery), false, Actor);
+	if (GetWorld()->LineTraceSingleByChannel(Hit, Location, End, ECC_Visibility, QueryParams))
+	{
+		return Location.Z - Hit.ImpactPoint.Z;
+	}
+	return -1.0f;
+}
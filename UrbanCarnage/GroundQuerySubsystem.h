@@ -0,0 +1,53 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "WorldCollision.h"
+#include "GroundQuerySubsystem.generated.h"
+
+class AUrbanCarnagePawn;
+
+/**
+ *  Ground detection for airborne vehicles
+ *  Heights come from the baked terrain height grid where it has one. Elsewhere, near dynamic geometry or on
+ *  maps without a grid, it probes straight down for all airborne vehicles in one batch of async traces whose
+ *  results are read on the next frame. A probe remembers the ground height it found, so the next one is only
+ *  issued when the vehicle could have come close to it at its current fall speed.
+ */
+UCLASS()
+class URBANCARNAGE_API UGroundQuerySubsystem : public UWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	// Begin USubsystem interface
+	virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+	virtual void Deinitialize() override;
+	// End USubsystem interface
+
+	/**
+	 * Collects last frame's probes and issues the ones that are due, lands vehicles that reached the ground.
+	 * Called once per frame by the vehicle tick subsystem with every airborne vehicle on the server.
+	 */
+	void Update(TConstArrayView<AUrbanCarnagePawn*> AirborneVehicles);
+
+	/** Synchronous height of Actor above the ground below it, from the height grid or a trace, -1 if there is none */
+	float GetHeightAboveGround(const AActor* Actor) const;
+
+protected:
+	struct FGroundQueryState
+	{
+		FTraceHandle TraceHandle;
+		double NextQueryTime = 0.0;
+		uint64 LastUpdateFrame = 0;
+		bool bPending = false;
+	};
+
+	void IssueProbe(AUrbanCarnagePawn* Vehicle, FGroundQueryState& State, bool bAsync);
+	/** Lands the vehicle or schedules its next probe, Hit is null if the probe found nothing */
+	void HandleProbeResult(AUrbanCarnagePawn* Vehicle, FGroundQueryState& State, const FHitResult* Hit);
+
+	TMap<TWeakObjectPtr<AUrbanCarnagePawn>, FGroundQueryState> States;
+};
@@ -0,0 +1,198 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "HitscanBatchSubsystem.h"
+#include "WeaponBase.h"
+#include "LagCompensationSubsystem.h"
+#include "Engine/World.h"
+#include "HAL/IConsoleManager.h"
+
+DECLARE_STATS_GROUP(TEXT("Hitscan"), STATGROUP_Hitscan, STATCAT_Advanced);
+DECLARE_CYCLE_STAT(TEXT("Hitscan Batch Tick"), STAT_HitscanBatchTick, STATGROUP_Hitscan);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Hitscan Shots"), STAT_HitscanShots, STATGROUP_Hitscan);
+
+static TAutoConsoleVariable<bool> CVarHitscanAsyncTraces(
+	TEXT("UrbanCarnage.Hitscan.AsyncTraces"),
+	true,
+	TEXT("If true, hitscan shots are traced async and resolved on the next frame."));
+
+bool UHitscanBatchSubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+	return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+void UHitscanBatchSubsystem::OnWorldBeginPlay(UWorld& InWorld)
+{
+	Super::OnWorldBeginPlay(InWorld);
+	bPlayCosmetics = InWorld.GetNetMode() != NM_DedicatedServer;
+}
+
+void UHitscanBatchSubsystem::Deinitialize()
+{
+	QueuedShots.Empty();
+	PendingShots.Empty();
+	Super::Deinitialize();
+}
+
+TStatId UHitscanBatchSubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UHitscanBatchSubsystem, STATGROUP_Hitscan);
+}
+
+void UHitscanBatchSubsystem::QueueShot(AWeaponBase* Weapon, const FVector& Origin, const FVector& Direction, bool bAuthoritative)
+{
+	if (!Weapon) return;
+	FHitscanShot& Shot = QueuedShots.AddDefaulted_GetRef();
+	Shot.Weapon = Weapon;
+	Shot.Start = Origin;
+	Shot.End = Origin + Direction.GetSafeNormal() * Weapon->HitscanRange;
+	Shot.bAuthoritative = bAuthoritative;
+	if (bAuthoritative)
+	{
+		if (const ULagCompensationSubsystem* LagCompensation = GetWorld()->GetSubsystem<ULagCompensationSubsystem>())
+		{
+			Shot.ViewTime = LagCompensation->GetViewTime(Weapon->GetOwner());
+		}
+	}
+}
+
+void UHitscanBatchSubsystem::Tick(float DeltaTime)
+{
+	SCOPE_CYCLE_COUNTER(STAT_HitscanBatchTick);
+
+	// results of last frame's async traces first, then this frame's shots
+	CollectAsyncResults();
+	TraceQueuedShots();
+}
+
+void UHitscanBatchSubsystem::TraceQueuedShots()
+{
+	if (QueuedShots.Num() == 0) return;
+	INC_DWORD_STAT_BY(STAT_HitscanShots, QueuedShots.Num());
+
+	UWorld* World = GetWorld();
+	const bool bAsync = CVarHitscanAsyncTraces.GetValueOnGameThread();
+	LagCompensateQueuedShots();
+	for (FHitscanShot& Shot : QueuedShots)
+	{
+		AWeaponBase* Weapon = Shot.Weapon.Get();
+		if (!Weapon) continue;
+
+		FCollisionQueryParams QueryParams(SCENE_QUERY_STAT(HitscanBatch), false);
+		Weapon->AddShooterIgnoredActors(QueryParams);
+		if (Shot.bLagCompensated)
+		{
+			// the vehicles were already tested where the shooter saw them
+			QueryParams.AddIgnoredActors(CompensatedVehicles);
+		}
+		if (bAsync)
+		{
+			Shot.TraceHandle = World->AsyncLineTraceByChannel(EAsyncTraceType::Single, Shot.Start, Shot.End, Weapon->ProjectileTraceChannel, QueryParams);
+			PendingShots.Add(Shot);
+		}
+		else
+		{
+			FHitResult Hit;
+			const bool bHit = World->LineTraceSingleByChannel(Hit, Shot.Start, Shot.End, Weapon->ProjectileTraceChannel, QueryParams);
+			ResolveHit(Shot, bHit ? &Hit : nullptr);
+		}
+	}
+	QueuedShots.Reset();
+}
+
+void UHitscanBatchSubsystem::LagCompensateQueuedShots()
+{
+	const ULagCompensationSubsystem* LagCompensation = GetWorld()->GetSubsystem<ULagCompensationSubsystem>();
+	if (!LagCompensation || !LagCompensation->IsEnabled()) return;
+
+	TArray<FLagCompensationQuery, TInlineAllocator<64>> Queries;
+	TArray<int32, TInlineAllocator<64>> ShotIndices;
+	for (int32 Index = 0; Index < QueuedShots.Num(); ++Index)
+	{
+		const FHitscanShot& Shot = QueuedShots[Index];
+		const AWeaponBase* Weapon = Shot.Weapon.Get();
+		if (!Shot.bAuthoritative || !Weapon) continue;
+		FLagCompensationQuery& Query = Queries.AddDefaulted_GetRef();
+		Query.Start = Shot.Start;
+		Query.End = Shot.End;
+		Query.ViewTime = Shot.ViewTime;
+		Query.IgnoredActor = Weapon->GetOwner();
+		ShotIndices.Add(Index);
+	}
+	if (Queries.Num() == 0) return;
+
+	TArray<FLagCompensationHit, TInlineAllocator<64>> Hits;
+	Hits.SetNum(Queries.Num());
+	LagCompensation->TraceShots(Queries, Hits);
+	LagCompensation->GetVehicles(CompensatedVehicles);
+	for (int32 QueryIndex = 0; QueryIndex < Queries.Num(); ++QueryIndex)
+	{
+		FHitscanShot& Shot = QueuedShots[ShotIndices[QueryIndex]];
+		const FLagCompensationHit& Hit = Hits[QueryIndex];
+		Shot.bLagCompensated = true;
+		Shot.RewoundVehicle = Hit.Vehicle;
+		Shot.RewoundImpactPoint = Hit.ImpactPoint;
+		Shot.RewoundImpactNormal = Hit.ImpactNormal;
+		Shot.RewoundDistance = Hit.Distance;
+	}
+}
+
+void UHitscanBatchSubsystem::CollectAsyncResults()
+{
+	UWorld* World = GetWorld();
+	for (int32 Index = PendingShots.Num() - 1; Index >= 0; --Index)
+	{
+		const FHitscanShot& Shot = PendingShots[Index];
+		FTraceDatum TraceData;
+		if (!World->QueryTraceData(Shot.TraceHandle, TraceData))
+		{
+			// not finished yet, the async trace buffer keeps it for one more frame
+			if (World->IsTraceHandleValid(Shot.TraceHandle, false)) continue;
+		}
+		else
+		{
+			const FHitResult* Hit = nullptr;
+			for (const FHitResult& Result : TraceData.OutHits)
+			{
+				if (Result.bBlockingHit)
+				{
+					Hit = &Result;
+					break;
+				}
+			}
+			ResolveHit(Shot, Hit);
+		}
+		PendingShots.RemoveAtSwap(Index, 1, EAllowShrinking::No);
+	}
+}
+
+void UHitscanBatchSubsystem::ResolveHit(const FHitscanShot& Shot, const FHitResult* Hit)
+{
+	AWeaponBase* Weapon = Shot.Weapon.Get();
+	if (!Weapon) return;
+
+	AActor* Target = Hit ? Hit->GetActor() : nullptr;
+	FVector ImpactPoint = Hit ? Hit->ImpactPoint : FVector::ZeroVector;
+	FVector ImpactNormal = Hit ? Hit->ImpactNormal : FVector::ZeroVector;
+	// a rewound vehicle in front of the blocking geometry takes the shot
+	AActor* RewoundVehicle = Shot.RewoundVehicle.Get();
+	if (RewoundVehicle && (!Hit || Shot.RewoundDistance < Hit->Distance))
+	{
+		Target = RewoundVehicle;
+		ImpactPoint = Shot.RewoundImpactPoint;
+		ImpactNormal = Shot.RewoundImpactNormal;
+	}
+	else if (!Hit)
+	{
+		return;
+	}
+
+	if (Shot.bAuthoritative && Target)
+	{
+		Weapon->ApplyHitDamage(Target, Weapon->Damage);
+	}
+	if (!Shot.bAuthoritative || bPlayCosmetics)
+	{
+		Weapon->SimulatedProjectileImpactBP(ImpactPoint, ImpactNormal);
+	}
+}
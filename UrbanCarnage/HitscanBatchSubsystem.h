@@ -0,0 +1,77 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "WorldCollision.h"
+#include "HitscanBatchSubsystem.generated.h"
+
+class AWeaponBase;
+
+/**
+ *  Resolves hitscan shots of all weapons in one batched pass
+ *  Shots are queued during the frame and traced together at the end of it. With async traces the results
+ *  are read back on the next tick. Hits go to UDamageAggregatorSubsystem, which applies them once per target.
+ *  On a server the vehicles are taken from ULagCompensationSubsystem, rewound to each shooter's view
+ *  time, and the world trace only looks for the geometry that could block the shot.
+ */
+UCLASS()
+class URBANCARNAGE_API UHitscanBatchSubsystem : public UTickableWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	// Begin USubsystem interface
+	virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+	virtual void OnWorldBeginPlay(UWorld& InWorld) override;
+	virtual void Deinitialize() override;
+	// End USubsystem interface
+
+	// Begin FTickableGameObject interface
+	virtual void Tick(float DeltaTime) override;
+	virtual TStatId GetStatId() const override;
+	// End FTickableGameObject interface
+
+	/**
+	 * Queues a shot for this frame's trace pass.
+	 * @param bAuthoritative	true on the server, hits deal damage, otherwise the shot is cosmetic only
+	 */
+	void QueueShot(AWeaponBase* Weapon, const FVector& Origin, const FVector& Direction, bool bAuthoritative);
+
+protected:
+	struct FHitscanShot
+	{
+		TWeakObjectPtr<AWeaponBase> Weapon;
+		FVector Start;
+		FVector End;
+		bool bAuthoritative;
+		FTraceHandle TraceHandle;
+		/** Server time the shooter saw, for the lag compensated vehicle hit */
+		double ViewTime = 0.0;
+		/** Closest rewound vehicle along the shot, the world trace ignores vehicles if set */
+		bool bLagCompensated = false;
+		TWeakObjectPtr<AActor> RewoundVehicle;
+		FVector RewoundImpactPoint = FVector::ZeroVector;
+		FVector RewoundImpactNormal = FVector::ZeroVector;
+		float RewoundDistance = 0.0f;
+	};
+
+	/** Issues the traces for QueuedShots, synchronously or async */
+	void TraceQueuedShots();
+	/** Validates the authoritative queued shots against the rewound vehicles in one batch */
+	void LagCompensateQueuedShots();
+	/** Collects results of async traces issued last frame */
+	void CollectAsyncResults();
+	void ResolveHit(const FHitscanShot& Shot, const FHitResult* Hit);
+
+	/** Shots queued this frame */
+	TArray<FHitscanShot> QueuedShots;
+	/** Shots whose async trace is in flight */
+	TArray<FHitscanShot> PendingShots;
+	/** Registered vehicles, ignored by the world trace of lag compensated shots */
+	TArray<AActor*> CompensatedVehicles;
+
+	/** True if cosmetic callbacks should run for authoritative shots (listen server or standalone) */
+	bool bPlayCosmetics = true;
+};
@@ -1,77 +1,225 @@
-// Fill out your copyright notice in the Description page of Project Settings.
-
-
-#include "InventoryComponent.h"
-#include "Net/UnrealNetwork.h"
-#include "GameFramework/Actor.h"
-
-
-// Sets default values for this component's properties
-UInventoryComponent::UInventoryComponent()
-{
-	SetIsReplicatedByDefault(true);
-}
-
-
-// Called when the game starts
-void UInventoryComponent::BeginPlay()
-{
-	Super::BeginPlay();
-
-	// ...
-	
-}
-
-
-void UInventoryComponent::AddItem(FName ItemID, int32 Amount)
-{
-    if (!GetOwner()->HasAuthority()) return;
-
-    for (FInventoryItem& Item : Inventory)
-    {
-        if (Item.ItemID == ItemID)
-        {
-            Item.Quantity += Amount;
-            return;
-        }
-    }
-
-    Inventory.Add(FInventoryItem(ItemID, Amount));
-}
-
-bool UInventoryComponent::ConsumeItem(FName ItemID, int32 Amount)
-{
-    if (!GetOwner()->HasAuthority()) return false;
-
-    for (FInventoryItem& Item : Inventory)
-    {
-        if (Item.ItemID == ItemID && Item.Quantity >= Amount)
-        {
-            Item.Quantity -= Amount;
-            if (Item.Quantity <= 0)
-            {
-                Inventory.Remove(Item);
-            }
-            return true;
-        }
-    }
-    return false;
-}
-
-int32 UInventoryComponent::GetItemQuantity(FName ItemID) const
-{
-    for (const FInventoryItem& Item : Inventory)
-    {
-        if (Item.ItemID == ItemID)
-        {
-            return Item.Quantity;
-        }
-    }
-    return 0;
-}
-
-void UInventoryComponent::GetLifetimeReplicatedProps(TArray<FLifetimeProperty>& OutLifetimeProps) const
-{
-    Super::GetLifetimeReplicatedProps(OutLifetimeProps);
-    DOREPLIFETIME(UInventoryComponent, Inventory);
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "InventoryComponent.h"
+#include "Net/UnrealNetwork.h"
+#include "Net/Core/PushModel/PushModel.h"
+#include "GameFramework/Actor.h"
+
+
+void FInventoryItem::PreReplicatedRemove(const FInventoryList& InArraySerializer)
+{
+    InArraySerializer.PendingItemEvents.Add({ FInventoryList::EItemEvent::Removed, Item, 0 });
+}
+
+void FInventoryItem::PostReplicatedAdd(const FInventoryList& InArraySerializer)
+{
+    InArraySerializer.PendingItemEvents.Add({ FInventoryList::EItemEvent::Added, Item, Quantity });
+}
+
+void FInventoryItem::PostReplicatedChange(const FInventoryList& InArraySerializer)
+{
+    InArraySerializer.PendingItemEvents.Add({ FInventoryList::EItemEvent::Changed, Item, Quantity });
+}
+
+FInventoryItem* FInventoryList::Find(FItemHandle Item)
+{
+    return const_cast<FInventoryItem*>(static_cast<const FInventoryList*>(this)->Find(Item));
+}
+
+const FInventoryItem* FInventoryList::Find(FItemHandle Item) const
+{
+    if (!Item.IsValid()) return nullptr;
+    const int32 Index = IndexById.IsValidIndex(Item.Id) ? IndexById[Item.Id] : INDEX_NONE;
+    if (Index == INDEX_NONE) return nullptr;
+    if (Items.IsValidIndex(Index) && Items[Index].Item == Item)
+    {
+        return &Items[Index];
+    }
+    // a client mid update may hold an index that no longer matches the list, the list itself is the truth
+    return Items.FindByPredicate([Item](const FInventoryItem& Entry) { return Entry.Item == Item; });
+}
+
+FInventoryItem& FInventoryList::Add(FItemHandle Item, int32 Quantity)
+{
+    // ids are dense, the index grows to the highest id we hold
+    while (IndexById.Num() <= Item.Id)
+    {
+        IndexById.Add(INDEX_NONE);
+    }
+    IndexById[Item.Id] = Items.Num();
+    FInventoryItem& Entry = Items.Emplace_GetRef(Item, Quantity);
+    MarkItemDirty(Entry);
+    return Entry;
+}
+
+void FInventoryList::Change(FInventoryItem& Entry)
+{
+    MarkItemDirty(Entry);
+}
+
+void FInventoryList::Remove(FItemHandle Item)
+{
+    const int32 Index = IndexById.IsValidIndex(Item.Id) ? IndexById[Item.Id] : INDEX_NONE;
+    if (Index == INDEX_NONE) return;
+    IndexById[Item.Id] = INDEX_NONE;
+    // the order does not matter, the last item takes the free spot
+    Items.RemoveAtSwap(Index, 1, EAllowShrinking::No);
+    if (Items.IsValidIndex(Index))
+    {
+        IndexById[Items[Index].Item.Id] = Index;
+    }
+    MarkArrayDirty();
+}
+
+void FInventoryList::RebuildIndex()
+{
+    int32 NumIds = IndexById.Num();
+    for (const FInventoryItem& Entry : Items)
+    {
+        NumIds = FMath::Max(NumIds, Entry.Item.Id + 1);
+    }
+    IndexById.Init(INDEX_NONE, NumIds);
+    for (int32 Index = 0; Index < Items.Num(); ++Index)
+    {
+        IndexById[Items[Index].Item.Id] = Index;
+    }
+}
+
+void FInventoryList::PostReplicatedReceive(const FFastArraySerializer::FPostReplicatedReceiveParameters& Parameters)
+{
+    // removals may have moved any item, handlers only run once the index matches the list again
+    RebuildIndex();
+    TArray<FPendingItemEvent> Events = MoveTemp(PendingItemEvents);
+    PendingItemEvents.Reset();
+    if (!OwnerComponent) return;
+    OwnerComponent->BroadcastItemEvents(Events);
+    OwnerComponent->OnInventoryChanged.Broadcast();
+}
+
+// Sets default values for this component's properties
+UInventoryComponent::UInventoryComponent()
+{
+	SetIsReplicatedByDefault(true);
+	Inventory.OwnerComponent = this;
+}
+
+
+// Called when the game starts
+void UInventoryComponent::BeginPlay()
+{
+	Super::BeginPlay();
+
+	// ...
+	
+}
+
+
+void UInventoryComponent::AddItem(FItemHandle Item, int32 Amount)
+{
+    // a negative add would consume
+    if (Amount <= 0) return;
+    FInventoryTransaction Transaction;
+    Transaction.Add(Item, Amount);
+    ApplyTransaction(Transaction);
+}
+
+bool UInventoryComponent::ConsumeItem(FItemHandle Item, int32 Amount)
+{
+    // a negative consume would add
+    if (Amount <= 0) return false;
+    FInventoryTransaction Transaction;
+    Transaction.Consume(Item, Amount);
+    return ApplyTransaction(Transaction);
+}
+
+int32 UInventoryComponent::GetItemQuantity(FItemHandle Item) const
+{
+    const FInventoryItem* Entry = Inventory.Find(Item);
+    return Entry ? Entry->Quantity : 0;
+}
+
+bool UInventoryComponent::ApplyTransaction(const FInventoryTransaction& Transaction)
+{
+    if (!GetOwner()->HasAuthority()) return false;
+
+    // one net change per item, a crate may list an item twice and a loadout may add and consume the same one
+    TArray<FInventoryChange, TInlineAllocator<16>> Merged;
+    for (const FInventoryChange& Change : Transaction.Changes)
+    {
+        if (!Change.Item.IsValid()) return false;
+        if (FInventoryChange* Existing = Merged.FindByPredicate([&Change](const FInventoryChange& Other) { return Other.Item == Change.Item; }))
+        {
+            Existing->Amount += Change.Amount;
+        }
+        else
+        {
+            Merged.Add(Change);
+        }
+    }
+
+    // check everything before the list is touched
+    for (const FInventoryChange& Change : Merged)
+    {
+        if (GetItemQuantity(Change.Item) + Change.Amount < 0) return false;
+    }
+
+    TArray<FInventoryList::FPendingItemEvent, TInlineAllocator<16>> Events;
+    for (const FInventoryChange& Change : Merged)
+    {
+        if (Change.Amount == 0) continue;
+        FInventoryItem* Entry = Inventory.Find(Change.Item);
+        if (!Entry)
+        {
+            Inventory.Add(Change.Item, Change.Amount);
+            Events.Add({ FInventoryList::EItemEvent::Added, Change.Item, Change.Amount });
+            continue;
+        }
+        Entry->Quantity += Change.Amount;
+        if (Entry->Quantity <= 0)
+        {
+            Inventory.Remove(Change.Item);
+            Events.Add({ FInventoryList::EItemEvent::Removed, Change.Item, 0 });
+        }
+        else
+        {
+            Inventory.Change(*Entry);
+            Events.Add({ FInventoryList::EItemEvent::Changed, Change.Item, Entry->Quantity });
+        }
+    }
+    if (Events.Num() > 0)
+    {
+        MARK_PROPERTY_DIRTY_FROM_NAME(UInventoryComponent, Inventory, this);
+        // listen server hosts and standalone players get the same item events as clients
+        BroadcastItemEvents(Events);
+        OnInventoryChanged.Broadcast();
+    }
+    return true;
+}
+
+void UInventoryComponent::BroadcastItemEvents(TConstArrayView<FInventoryList::FPendingItemEvent> Events)
+{
+    for (const FInventoryList::FPendingItemEvent& Pending : Events)
+    {
+        switch (Pending.Event)
+        {
+        case FInventoryList::EItemEvent::Added:
+            OnItemAdded.Broadcast(Pending.Item, Pending.Quantity);
+            break;
+        case FInventoryList::EItemEvent::Changed:
+            OnItemChanged.Broadcast(Pending.Item, Pending.Quantity);
+            break;
+        case FInventoryList::EItemEvent::Removed:
+            OnItemRemoved.Broadcast(Pending.Item, Pending.Quantity);
+            break;
+        }
+    }
+}
+
+void UInventoryComponent::GetLifetimeReplicatedProps(TArray<FLifetimeProperty>& OutLifetimeProps) const
+{
+    Super::GetLifetimeReplicatedProps(OutLifetimeProps);
+    FDoRepLifetimeParams Params;
+    Params.bIsPushBased = true;
+    DOREPLIFETIME_WITH_PARAMS_FAST(UInventoryComponent, Inventory, Params);
 }
\ No newline at end of file
@@ -1,59 +1,189 @@
-// Fill out your copyright notice in the Description page of Project Settings.
-
-#pragma once
-
-#include "CoreMinimal.h"
-#include "Components/ActorComponent.h"
-#include "InventoryComponent.generated.h"
-
-USTRUCT(BlueprintType)
-struct FInventoryItem
-{
-    GENERATED_BODY()
-
-public:
-    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Inventory")
-    FName ItemID;  // Unique Item Name (e.g., "Medkit", "Nitro", "Shield")
-
-    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Inventory")
-    int32 Quantity;  // Amount of this item
-
-    FInventoryItem()
-        : ItemID(NAME_None), Quantity(0) {
-    }
-
-    FInventoryItem(FName InItemID, int32 InQuantity)
-        : ItemID(InItemID), Quantity(InQuantity) {
-    }
-    bool operator==(const FInventoryItem& Other) const
-    {
-        return ItemID == Other.ItemID && Quantity == Other.Quantity;
-    }
-};
-
-UCLASS( ClassGroup=(Custom), meta=(BlueprintSpawnableComponent) )
-class URBANCARNAGE_API UInventoryComponent : public UActorComponent
-{
-    GENERATED_BODY()
-
-public:
-    UInventoryComponent();
-
-protected:
-    virtual void BeginPlay() override;
-
-public:
-    UFUNCTION(BlueprintCallable, Category = "Inventory")
-    void AddItem(FName ItemID, int32 Amount);
-
-    UFUNCTION(BlueprintCallable, Category = "Inventory")
-    bool ConsumeItem(FName ItemID, int32 Amount);
-
-    UFUNCTION(BlueprintCallable, Category = "Inventory")
-    int32 GetItemQuantity(FName ItemID) const;
-
-    UPROPERTY(Replicated, BlueprintReadOnly, Category = "Inventory")
-    TArray<FInventoryItem> Inventory;
-
-    virtual void GetLifetimeReplicatedProps(TArray<FLifetimeProperty>& OutLifetimeProps) const override;
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Components/ActorComponent.h"
+#include "Net/Serialization/FastArraySerializer.h"
+#include "ItemDefinition.h"
+#include "InventoryComponent.generated.h"
+
+class UInventoryComponent;
+struct FInventoryList;
+
+USTRUCT(BlueprintType)
+struct FInventoryItem : public FFastArraySerializerItem
+{
+    GENERATED_BODY()
+
+public:
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Inventory")
+    FItemHandle Item;  // Registry id of the item (e.g., Medkit, Nitro, Shield), see UItemRegistrySubsystem
+
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Inventory")
+    int32 Quantity;  // Amount of this item
+
+    FInventoryItem()
+        : Quantity(0) {
+    }
+
+    FInventoryItem(FItemHandle InItem, int32 InQuantity)
+        : Item(InItem), Quantity(InQuantity) {
+    }
+    bool operator==(const FInventoryItem& Other) const
+    {
+        return Item == Other.Item && Quantity == Other.Quantity;
+    }
+
+    // Client side fast array callbacks, queued for the component's delegates until the index is rebuilt
+    void PreReplicatedRemove(const FInventoryList& InArraySerializer);
+    void PostReplicatedAdd(const FInventoryList& InArraySerializer);
+    void PostReplicatedChange(const FInventoryList& InArraySerializer);
+};
+
+/**
+ *  Items of an inventory, delta replicated per entry
+ *  Only added, changed and removed items are sent. IndexById finds an item by its dense registry id without
+ *  a scan, the server keeps it up to date as it edits the list, clients rebuild it after every update.
+ */
+USTRUCT(BlueprintType)
+struct FInventoryList : public FFastArraySerializer
+{
+    GENERATED_BODY()
+
+    UPROPERTY(BlueprintReadOnly, Category = "Inventory")
+    TArray<FInventoryItem> Items;
+
+    /** Component the list belongs to, receives the per item callbacks. Set by its constructor */
+    UInventoryComponent* OwnerComponent = nullptr;
+
+    /** Index into Items by item id, INDEX_NONE for items we do not have */
+    TArray<int32> IndexById;
+
+    enum class EItemEvent : uint8 { Added, Changed, Removed };
+    struct FPendingItemEvent
+    {
+        EItemEvent Event;
+        FItemHandle Item;
+        int32 Quantity;
+    };
+    /** Client side, item callbacks of the update being received, broadcast by PostReplicatedReceive */
+    mutable TArray<FPendingItemEvent> PendingItemEvents;
+
+    /** Entry of Item, nullptr if there is none */
+    FInventoryItem* Find(FItemHandle Item);
+    const FInventoryItem* Find(FItemHandle Item) const;
+
+    /** Server side edits, mark the changed entries for replication */
+    FInventoryItem& Add(FItemHandle Item, int32 Quantity);
+    void Change(FInventoryItem& Entry);
+    void Remove(FItemHandle Item);
+
+    void RebuildIndex();
+
+    // Begin FFastArraySerializer interface
+    void PostReplicatedReceive(const FFastArraySerializer::FPostReplicatedReceiveParameters& Parameters);
+    // End FFastArraySerializer interface
+
+    bool NetDeltaSerialize(FNetDeltaSerializeInfo& DeltaParms)
+    {
+        return FFastArraySerializer::FastArrayDeltaSerialize<FInventoryItem, FInventoryList>(Items, DeltaParms, *this);
+    }
+};
+
+template<>
+struct TStructOpsTypeTraits<FInventoryList> : public TStructOpsTypeTraitsBase2<FInventoryList>
+{
+    enum
+    {
+        WithNetDeltaSerializer = true,
+    };
+};
+
+/** One quantity change of an inventory transaction, negative amounts consume */
+USTRUCT(BlueprintType)
+struct FInventoryChange
+{
+    GENERATED_BODY()
+
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Inventory")
+    FItemHandle Item;
+
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Inventory")
+    int32 Amount = 0;
+};
+
+/** Adds and consumes applied together by UInventoryComponent::ApplyTransaction, all of them or none */
+USTRUCT(BlueprintType)
+struct FInventoryTransaction
+{
+    GENERATED_BODY()
+
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Inventory")
+    TArray<FInventoryChange> Changes;
+
+    void Add(FItemHandle Item, int32 Amount) { Changes.Add({ Item, Amount }); }
+    void Consume(FItemHandle Item, int32 Amount) { Changes.Add({ Item, -Amount }); }
+};
+
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_TwoParams(FOnInventoryItemEvent, FItemHandle, Item, int32, Quantity);
+DECLARE_DYNAMIC_MULTICAST_DELEGATE(FOnInventoryChanged);
+
+UCLASS( ClassGroup=(Custom), meta=(BlueprintSpawnableComponent) )
+class URBANCARNAGE_API UInventoryComponent : public UActorComponent
+{
+    GENERATED_BODY()
+
+public:
+    UInventoryComponent();
+
+protected:
+    virtual void BeginPlay() override;
+
+public:
+    /** Server side, Amount has to be positive */
+    UFUNCTION(BlueprintCallable, Category = "Inventory")
+    void AddItem(FItemHandle Item, int32 Amount);
+
+    /** Server side, false if Amount is not positive or we hold less than it */
+    UFUNCTION(BlueprintCallable, Category = "Inventory")
+    bool ConsumeItem(FItemHandle Item, int32 Amount);
+
+    UFUNCTION(BlueprintCallable, Category = "Inventory")
+    int32 GetItemQuantity(FItemHandle Item) const;
+
+    /**
+     * Server side, applies every change of Transaction or none of them. All changes are checked before the
+     * list is touched, then they go out as one replication delta with one OnInventoryChanged.
+     * @return false if an item is invalid or would drop below zero
+     */
+    UFUNCTION(BlueprintCallable, Category = "Inventory")
+    bool ApplyTransaction(const FInventoryTransaction& Transaction);
+
+    UPROPERTY(Replicated, BlueprintReadOnly, Category = "Inventory")
+    FInventoryList Inventory;
+
+    /** Items of the inventory, Blueprints used to read them from Inventory directly before it became a fast array */
+    UFUNCTION(BlueprintPure, Category = "Inventory")
+    const TArray<FInventoryItem>& GetItems() const { return Inventory.Items; }
+
+    /** Called once per transaction on the server and once per replicated update on clients */
+    UPROPERTY(BlueprintAssignable, Category = "Inventory")
+    FOnInventoryChanged OnInventoryChanged;
+
+    /**
+     * Called for every item that shows up, changes quantity or runs out: on the server right after its
+     * transaction, on clients after the whole replicated update arrived
+     */
+    UPROPERTY(BlueprintAssignable, Category = "Inventory")
+    FOnInventoryItemEvent OnItemAdded;
+    UPROPERTY(BlueprintAssignable, Category = "Inventory")
+    FOnInventoryItemEvent OnItemChanged;
+    UPROPERTY(BlueprintAssignable, Category = "Inventory")
+    FOnInventoryItemEvent OnItemRemoved;
+
+    /** Broadcasts OnItemAdded, OnItemChanged or OnItemRemoved for each event */
+    void BroadcastItemEvents(TConstArrayView<FInventoryList::FPendingItemEvent> Events);
+
+    virtual void GetLifetimeReplicatedProps(TArray<FLifetimeProperty>& OutLifetimeProps) const override;
 };
\ No newline at end of file
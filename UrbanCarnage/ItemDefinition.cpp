@@ -0,0 +1,12 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "ItemDefinition.h"
+#include "WeaponBase.h"
+
+const FPrimaryAssetType UItemDefinition::AssetType(TEXT("ItemDefinition"));
+
+FPrimaryAssetId UItemDefinition::GetPrimaryAssetId() const
+{
+	return FPrimaryAssetId(AssetType, GetFName());
+}
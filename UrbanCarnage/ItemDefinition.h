@@ -0,0 +1,66 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Engine/DataAsset.h"
+#include "ItemDefinition.generated.h"
+
+class AWeaponBase;
+
+/**
+ *  Compact reference to an item of UItemRegistrySubsystem
+ *  Replicates as a 16-bit id, 0 is no item. Ids are only valid in the running game, save the ItemName.
+ */
+USTRUCT(BlueprintType)
+struct FItemHandle
+{
+	GENERATED_BODY()
+
+	UPROPERTY()
+	uint16 Id = 0;
+
+	FItemHandle() = default;
+	explicit FItemHandle(uint16 InId) : Id(InId) {}
+
+	bool IsValid() const { return Id != 0; }
+	bool operator==(const FItemHandle& Other) const { return Id == Other.Id; }
+	bool operator!=(const FItemHandle& Other) const { return Id != Other.Id; }
+	friend uint32 GetTypeHash(const FItemHandle& Handle) { return Handle.Id; }
+};
+
+/**
+ *  Data asset describing one inventory item or weapon pickup
+ *  All of them are found through the Asset Manager, add the ItemDefinition primary asset type to its
+ *  scanned directories so they are cooked.
+ */
+UCLASS(BlueprintType)
+class URBANCARNAGE_API UItemDefinition : public UPrimaryDataAsset
+{
+	GENERATED_BODY()
+
+public:
+	static const FPrimaryAssetType AssetType;
+
+	/** Stable key of the item, ids are assigned in the order of these names so servers and clients agree */
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Item")
+	FName ItemName;
+
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Item")
+	FText DisplayName;
+
+	/** Kind of item, e.g. Weapon, Medkit or Nitro */
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Item")
+	FName ItemType;
+
+	/** Weapon equipped when this item is picked up, none for plain inventory items */
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Item")
+	TSubclassOf<AWeaponBase> WeaponClass;
+
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Item", meta = (EditCondition = "WeaponClass != nullptr"))
+	bool bPrimaryWeapon = false;
+
+	// Begin UPrimaryDataAsset interface
+	virtual FPrimaryAssetId GetPrimaryAssetId() const override;
+	// End UPrimaryDataAsset interface
+};
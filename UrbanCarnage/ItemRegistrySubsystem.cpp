@@ -0,0 +1,88 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "ItemRegistrySubsystem.h"
+#include "Engine/AssetManager.h"
+#include "Engine/GameInstance.h"
+#include "Engine/World.h"
+
+DEFINE_LOG_CATEGORY_STATIC(LogItemRegistry, Log, All);
+
+void UItemRegistrySubsystem::Initialize(FSubsystemCollectionBase& Collection)
+{
+	Super::Initialize(Collection);
+	Definitions.Reset();
+	IdsByName.Reset();
+	Definitions.Add(nullptr);
+
+	UAssetManager* AssetManager = UAssetManager::GetIfInitialized();
+	if (!AssetManager)
+	{
+		UE_LOG(LogItemRegistry, Warning, TEXT("No asset manager, the item registry is empty"));
+		return;
+	}
+
+	// item definitions are small, load them all up front so lookups never wait
+	TArray<FPrimaryAssetId> AssetIds;
+	AssetManager->GetPrimaryAssetIdList(UItemDefinition::AssetType, AssetIds);
+	TArray<UItemDefinition*> Loaded;
+	for (const FPrimaryAssetId& AssetId : AssetIds)
+	{
+		UItemDefinition* Definition = Cast<UItemDefinition>(AssetManager->GetPrimaryAssetPath(AssetId).TryLoad());
+		if (!Definition || Definition->ItemName.IsNone())
+		{
+			UE_LOG(LogItemRegistry, Warning, TEXT("Skipping item %s, it failed to load or has no ItemName"), *AssetId.ToString());
+			continue;
+		}
+		Loaded.Add(Definition);
+	}
+
+	// ids follow the sorted names, not the scan order, so every machine agrees on them
+	Loaded.Sort([](const UItemDefinition& A, const UItemDefinition& B) { return A.ItemName.Compare(B.ItemName) < 0; });
+	for (UItemDefinition* Definition : Loaded)
+	{
+		if (Definitions.Num() > MAX_uint16)
+		{
+			UE_LOG(LogItemRegistry, Error, TEXT("More than %d items, the rest is not registered"), MAX_uint16);
+			break;
+		}
+		if (IdsByName.Contains(Definition->ItemName))
+		{
+			UE_LOG(LogItemRegistry, Warning, TEXT("Item name %s is used twice, skipping %s"), *Definition->ItemName.ToString(), *GetNameSafe(Definition));
+			continue;
+		}
+		IdsByName.Add(Definition->ItemName, (uint16)Definitions.Num());
+		Definitions.Add(Definition);
+	}
+	UE_LOG(LogItemRegistry, Log, TEXT("Registered %d items"), Definitions.Num() - 1);
+}
+
+void UItemRegistrySubsystem::Deinitialize()
+{
+	Definitions.Empty();
+	IdsByName.Empty();
+	Super::Deinitialize();
+}
+
+UItemRegistrySubsystem* UItemRegistrySubsystem::Get(const UObject* WorldContextObject)
+{
+	const UWorld* World = WorldContextObject ? WorldContextObject->GetWorld() : nullptr;
+	const UGameInstance* GameInstance = World ? World->GetGameInstance() : nullptr;
+	return GameInstance ? GameInstance->GetSubsystem<UItemRegistrySubsystem>() : nullptr;
+}
+
+UItemDefinition* UItemRegistrySubsystem::GetItemDefinition(FItemHandle Item) const
+{
+	return Definitions.IsValidIndex(Item.Id) ? Definitions[Item.Id].Get() : nullptr;
+}
+
+FItemHandle UItemRegistrySubsystem::FindItem(FName ItemName) const
+{
+	const uint16* Id = IdsByName.Find(ItemName);
+	return Id ? FItemHandle(*Id) : FItemHandle();
+}
+
+FItemHandle UItemRegistrySubsystem::GetItemHandle(const UItemDefinition* Definition) const
+{
+	return Definition ? FindItem(Definition->ItemName) : FItemHandle();
+}
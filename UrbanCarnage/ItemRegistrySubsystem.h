@@ -0,0 +1,49 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/GameInstanceSubsystem.h"
+#include "ItemDefinition.h"
+#include "ItemRegistrySubsystem.generated.h"
+
+/**
+ *  Assigns dense 16-bit ids to every UItemDefinition at startup
+ *  The definitions are loaded from the Asset Manager and sorted by ItemName, so the same content gives the
+ *  same ids on the server and every client. Inventory entries and pickups carry FItemHandle ids, the
+ *  registry resolves them to their definition by array index.
+ */
+UCLASS()
+class URBANCARNAGE_API UItemRegistrySubsystem : public UGameInstanceSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	// Begin USubsystem interface
+	virtual void Initialize(FSubsystemCollectionBase& Collection) override;
+	virtual void Deinitialize() override;
+	// End USubsystem interface
+
+	static UItemRegistrySubsystem* Get(const UObject* WorldContextObject);
+
+	/** Definition of an item, nullptr for an invalid handle */
+	UFUNCTION(BlueprintPure, Category = "Item")
+	UItemDefinition* GetItemDefinition(FItemHandle Item) const;
+
+	/** Handle of the item named ItemName, invalid if there is none. For authoring, runtime code keeps handles */
+	UFUNCTION(BlueprintPure, Category = "Item")
+	FItemHandle FindItem(FName ItemName) const;
+
+	UFUNCTION(BlueprintPure, Category = "Item")
+	FItemHandle GetItemHandle(const UItemDefinition* Definition) const;
+
+	/** One past the highest id */
+	int32 GetNumIds() const { return Definitions.Num(); }
+
+protected:
+	/** Indexed by id, slot 0 is the invalid id */
+	UPROPERTY(Transient)
+	TArray<TObjectPtr<UItemDefinition>> Definitions;
+
+	TMap<FName, uint16> IdsByName;
+};
@@ -0,0 +1,217 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "LagCompensationSubsystem.h"
+#include "UrbanCarnagePawn.h"
+#include "Engine/World.h"
+#include "Components/SkeletalMeshComponent.h"
+#include "GameFramework/PlayerState.h"
+#include "HAL/IConsoleManager.h"
+
+DECLARE_STATS_GROUP(TEXT("LagCompensation"), STATGROUP_LagCompensation, STATCAT_Advanced);
+DECLARE_CYCLE_STAT(TEXT("Record Frame"), STAT_LagCompensationRecord, STATGROUP_LagCompensation);
+DECLARE_CYCLE_STAT(TEXT("Trace Shots"), STAT_LagCompensationTrace, STATGROUP_LagCompensation);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Rewound Shots"), STAT_LagCompensationShots, STATGROUP_LagCompensation);
+
+static TAutoConsoleVariable<bool> CVarLagCompensationEnabled(
+	TEXT("UrbanCarnage.LagComp.Enabled"),
+	true,
+	TEXT("If true, server side hits are validated against vehicles rewound to the shooter's view time."));
+
+static TAutoConsoleVariable<int32> CVarLagCompensationHistoryFrames(
+	TEXT("UrbanCarnage.LagComp.HistoryFrames"),
+	64,
+	TEXT("Frames of vehicle history kept per vehicle, read when the world begins play."));
+
+static TAutoConsoleVariable<float> CVarLagCompensationMaxRewindTime(
+	TEXT("UrbanCarnage.LagComp.MaxRewindTime"),
+	0.4f,
+	TEXT("Longest rewind granted to a shooter, in seconds. Players with more latency have to lead their shots."));
+
+bool ULagCompensationSubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+	return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+void ULagCompensationSubsystem::OnWorldBeginPlay(UWorld& InWorld)
+{
+	Super::OnWorldBeginPlay(InWorld);
+	const ENetMode NetMode = InWorld.GetNetMode();
+	bEnabled = NetMode == NM_DedicatedServer || NetMode == NM_ListenServer;
+	// the whole history is allocated up front, vehicles x frames samples
+	HistoryFrames = FMath::Clamp(CVarLagCompensationHistoryFrames.GetValueOnGameThread(), 2, 1024);
+	FrameTimes.SetNumZeroed(HistoryFrames);
+}
+
+void ULagCompensationSubsystem::Deinitialize()
+{
+	Histories.Empty();
+	FrameTimes.Empty();
+	Super::Deinitialize();
+}
+
+TStatId ULagCompensationSubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(ULagCompensationSubsystem, STATGROUP_LagCompensation);
+}
+
+bool ULagCompensationSubsystem::IsEnabled() const
+{
+	return bEnabled && NumFrames > 0 && CVarLagCompensationEnabled.GetValueOnGameThread();
+}
+
+void ULagCompensationSubsystem::RegisterVehicle(AUrbanCarnagePawn* Vehicle)
+{
+	if (!bEnabled || !Vehicle) return;
+	if (Histories.ContainsByPredicate([Vehicle](const FVehicleHistory& History) { return History.Vehicle == Vehicle; })) return;
+
+	FVehicleHistory& History = Histories.AddDefaulted_GetRef();
+	History.Vehicle = Vehicle;
+	History.LocalBounds = Vehicle->GetMesh()->CalcBounds(FTransform::Identity).GetBox();
+	History.BoundsRadius = History.LocalBounds.GetCenter().Size() + History.LocalBounds.GetExtent().Size();
+	History.Samples.SetNumZeroed(HistoryFrames);
+}
+
+void ULagCompensationSubsystem::UnregisterVehicle(AUrbanCarnagePawn* Vehicle)
+{
+	const int32 Index = Histories.IndexOfByPredicate([Vehicle](const FVehicleHistory& History) { return History.Vehicle == Vehicle; });
+	if (Index != INDEX_NONE)
+	{
+		Histories.RemoveAtSwap(Index, 1, EAllowShrinking::No);
+	}
+}
+
+void ULagCompensationSubsystem::GetVehicles(TArray<AActor*>& OutVehicles) const
+{
+	OutVehicles.Reset(Histories.Num());
+	for (const FVehicleHistory& History : Histories)
+	{
+		if (AUrbanCarnagePawn* Vehicle = History.Vehicle.Get())
+		{
+			OutVehicles.Add(Vehicle);
+		}
+	}
+}
+
+void ULagCompensationSubsystem::Tick(float DeltaTime)
+{
+	if (bEnabled)
+	{
+		RecordFrame();
+	}
+}
+
+void ULagCompensationSubsystem::RecordFrame()
+{
+	SCOPE_CYCLE_COUNTER(STAT_LagCompensationRecord);
+	const double Now = GetWorld()->GetTimeSeconds();
+	if (Now <= LastRecordTime) return;
+	LastRecordTime = Now;
+
+	NewestSlot = (NewestSlot + 1) % HistoryFrames;
+	NumFrames = FMath::Min(NumFrames + 1, HistoryFrames);
+	FrameTimes[NewestSlot] = Now;
+	for (int32 Index = Histories.Num() - 1; Index >= 0; --Index)
+	{
+		FVehicleHistory& History = Histories[Index];
+		const AUrbanCarnagePawn* Vehicle = History.Vehicle.Get();
+		if (!IsValid(Vehicle))
+		{
+			Histories.RemoveAtSwap(Index, 1, EAllowShrinking::No);
+			continue;
+		}
+		FVehicleSample& Sample = History.Samples[NewestSlot];
+		Sample.Location = Vehicle->GetActorLocation();
+		Sample.Rotation = FQuat4f(Vehicle->GetActorQuat());
+		History.NumRecorded = FMath::Min(History.NumRecorded + 1, HistoryFrames);
+	}
+}
+
+bool ULagCompensationSubsystem::FindFrames(double Time, int32& OutOlderAge, int32& OutNewerAge, float& OutAlpha) const
+{
+	if (NumFrames == 0) return false;
+	// rewinds are short, walk back from the newest frame
+	OutNewerAge = 0;
+	for (int32 Age = 0; Age < NumFrames; ++Age)
+	{
+		const double FrameTime = FrameTimes[GetSlot(Age)];
+		if (FrameTime <= Time)
+		{
+			OutOlderAge = Age;
+			const double NewerTime = FrameTimes[GetSlot(OutNewerAge)];
+			OutAlpha = NewerTime > FrameTime ? (float)((Time - FrameTime) / (NewerTime - FrameTime)) : 1.0f;
+			OutAlpha = FMath::Clamp(OutAlpha, 0.0f, 1.0f);
+			return true;
+		}
+		OutNewerAge = Age;
+	}
+	// older than the history, use the oldest frame
+	OutOlderAge = NumFrames - 1;
+	OutNewerAge = NumFrames - 1;
+	OutAlpha = 0.0f;
+	return true;
+}
+
+double ULagCompensationSubsystem::GetViewTime(const AActor* Shooter) const
+{
+	const double Now = GetWorld()->GetTimeSeconds();
+	const AUrbanCarnagePawn* Vehicle = Cast<AUrbanCarnagePawn>(Shooter);
+	const APlayerState* PlayerState = Vehicle ? Vehicle->GetPlayerState() : nullptr;
+	if (!PlayerState || Vehicle->IsLocallyControlled()) return Now;
+	// the shot left the client half a round trip ago, and the client showed the other vehicles
+	// its snapshot interpolation delay behind that
+	const float Rewind = PlayerState->GetPingInMilliseconds() * 0.0005f + Vehicle->SnapshotInterpolationDelay;
+	return Now - FMath::Min(Rewind, CVarLagCompensationMaxRewindTime.GetValueOnGameThread());
+}
+
+void ULagCompensationSubsystem::TraceShots(TConstArrayView<FLagCompensationQuery> Queries, TArrayView<FLagCompensationHit> OutHits) const
+{
+	SCOPE_CYCLE_COUNTER(STAT_LagCompensationTrace);
+	check(Queries.Num() == OutHits.Num());
+	INC_DWORD_STAT_BY(STAT_LagCompensationShots, Queries.Num());
+
+	for (int32 QueryIndex = 0; QueryIndex < Queries.Num(); ++QueryIndex)
+	{
+		const FLagCompensationQuery& Query = Queries[QueryIndex];
+		FLagCompensationHit& Hit = OutHits[QueryIndex];
+		Hit = FLagCompensationHit();
+
+		// the frames are the same for every vehicle, only looked up once per shot
+		int32 OlderAge, NewerAge;
+		float Alpha;
+		if (!FindFrames(Query.ViewTime, OlderAge, NewerAge, Alpha)) continue;
+		const float Length = (Query.End - Query.Start).Size();
+		float ClosestDistance = MAX_flt;
+
+		for (const FVehicleHistory& History : Histories)
+		{
+			AUrbanCarnagePawn* Vehicle = History.Vehicle.Get();
+			if (!Vehicle || Vehicle == Query.IgnoredActor || History.NumRecorded == 0) continue;
+
+			// vehicles registered after the view time are rewound as far as they go
+			const int32 OldestAge = FMath::Min(History.NumRecorded, NumFrames) - 1;
+			const FVehicleSample& Older = History.Samples[GetSlot(FMath::Min(OlderAge, OldestAge))];
+			const FVehicleSample& Newer = History.Samples[GetSlot(FMath::Min(NewerAge, OldestAge))];
+			const FVector Location = FMath::Lerp(Older.Location, Newer.Location, (double)Alpha);
+			if (FMath::PointDistToSegmentSquared(Location, Query.Start, Query.End) > FMath::Square(History.BoundsRadius)) continue;
+
+			// into vehicle space, where the bounds are an axis aligned box
+			const FQuat Rotation(FQuat4f::Slerp(Older.Rotation, Newer.Rotation, Alpha));
+			const FTransform Transform(Rotation, Location);
+			FVector LocalHit, LocalNormal;
+			float HitTime;
+			if (!FMath::LineExtentBoxIntersection(History.LocalBounds, Transform.InverseTransformPositionNoScale(Query.Start),
+				Transform.InverseTransformPositionNoScale(Query.End), FVector::ZeroVector, LocalHit, LocalNormal, HitTime))
+			{
+				continue;
+			}
+			const float Distance = HitTime * Length;
+			if (Distance >= ClosestDistance) continue;
+			ClosestDistance = Distance;
+			Hit.Vehicle = Vehicle;
+			Hit.ImpactPoint = Transform.TransformPositionNoScale(LocalHit);
+			Hit.ImpactNormal = Rotation.RotateVector(LocalNormal);
+			Hit.Distance = Distance;
+		}
+	}
+}
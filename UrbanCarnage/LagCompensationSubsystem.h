@@ -0,0 +1,105 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "LagCompensationSubsystem.generated.h"
+
+class AUrbanCarnagePawn;
+
+/** One shot to validate against the rewound vehicles */
+struct FLagCompensationQuery
+{
+	FVector Start = FVector::ZeroVector;
+	FVector End = FVector::ZeroVector;
+	/** Server time the shooter saw the world at, see ULagCompensationSubsystem::GetViewTime */
+	double ViewTime = 0.0;
+	/** Usually the shooting vehicle */
+	const AActor* IgnoredActor = nullptr;
+};
+
+/** Closest rewound vehicle along a query, Vehicle is null if nothing was hit */
+struct FLagCompensationHit
+{
+	AUrbanCarnagePawn* Vehicle = nullptr;
+	FVector ImpactPoint = FVector::ZeroVector;
+	FVector ImpactNormal = FVector::ZeroVector;
+	/** Distance from the query start */
+	float Distance = 0.0f;
+};
+
+/**
+ *  Server side history of vehicle transforms and bounds for hit validation
+ *  Every server tick the transform and bounds of each registered vehicle go into a fixed size ring
+ *  (UrbanCarnage.LagComp.HistoryFrames, all vehicles share the frame slots). Shots are validated in
+ *  batches: each query rewinds the vehicles to its view time and tests the segment against their
+ *  oriented bounds, without touching the physics scene.
+ */
+UCLASS()
+class URBANCARNAGE_API ULagCompensationSubsystem : public UTickableWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	// Begin USubsystem interface
+	virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+	virtual void OnWorldBeginPlay(UWorld& InWorld) override;
+	virtual void Deinitialize() override;
+	// End USubsystem interface
+
+	// Begin FTickableGameObject interface
+	virtual void Tick(float DeltaTime) override;
+	virtual TStatId GetStatId() const override;
+	// End FTickableGameObject interface
+
+	void RegisterVehicle(AUrbanCarnagePawn* Vehicle);
+	void UnregisterVehicle(AUrbanCarnagePawn* Vehicle);
+
+	/** True on a server with history to rewind */
+	bool IsEnabled() const;
+
+	/** Server time the shooter's client was showing when it fired, now for local and non player shooters */
+	double GetViewTime(const AActor* Shooter) const;
+
+	/** Validates a batch of shots, OutHits[i] is the closest rewound vehicle hit by Queries[i] */
+	void TraceShots(TConstArrayView<FLagCompensationQuery> Queries, TArrayView<FLagCompensationHit> OutHits) const;
+
+	/** Registered vehicles, for traces that have to skip the current vehicle positions */
+	void GetVehicles(TArray<AActor*>& OutVehicles) const;
+
+protected:
+	struct FVehicleSample
+	{
+		FVector Location;
+		FQuat4f Rotation;
+	};
+
+	struct FVehicleHistory
+	{
+		TWeakObjectPtr<AUrbanCarnagePawn> Vehicle;
+		/** Bounds in vehicle space, taken at registration */
+		FBox LocalBounds;
+		/** Radius of a sphere around the vehicle origin enclosing LocalBounds, for the broad phase */
+		float BoundsRadius = 0.0f;
+		/** Number of frames recorded since registration, older slots are invalid */
+		int32 NumRecorded = 0;
+		/** One sample per frame slot, same indexing as FrameTimes */
+		TArray<FVehicleSample> Samples;
+	};
+
+	void RecordFrame();
+	/** Ages of the frames around Time and the blend from the older to the newer one, false without history */
+	bool FindFrames(double Time, int32& OutOlderAge, int32& OutNewerAge, float& OutAlpha) const;
+	/** Slot of the frame Age frames before the newest one */
+	int32 GetSlot(int32 Age) const { return (NewestSlot - Age + HistoryFrames) % HistoryFrames; }
+
+	TArray<FVehicleHistory> Histories;
+	/** Server time of each frame slot */
+	TArray<double> FrameTimes;
+	int32 HistoryFrames = 0;
+	int32 NewestSlot = -1;
+	int32 NumFrames = 0;
+	double LastRecordTime = -1.0;
+	bool bEnabled = false;
+};
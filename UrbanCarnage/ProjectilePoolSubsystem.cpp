@@ -0,0 +1,219 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "ProjectilePoolSubsystem.h"
+#include "Core/BulletBase.h"
+#include "Engine/World.h"
+#include "GameFramework/ProjectileMovementComponent.h"
+
+DECLARE_DWORD_COUNTER_STAT(TEXT("Pool Misses"), STAT_ProjectilePoolMisses, STATGROUP_ProjectilePool);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Pool Leaks"), STAT_ProjectilePoolLeaks, STATGROUP_ProjectilePool);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Active Projectiles"), STAT_ProjectilePoolActive, STATGROUP_ProjectilePool);
+DECLARE_CYCLE_STAT(TEXT("Projectile Pool Tick"), STAT_ProjectilePoolTick, STATGROUP_ProjectilePool);
+
+DEFINE_LOG_CATEGORY_STATIC(LogProjectilePool, Log, All);
+
+bool UProjectilePoolSubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+	return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+void UProjectilePoolSubsystem::Deinitialize()
+{
+	UE_LOG(LogProjectilePool, Log, TEXT("Projectile pool shut down, %d misses, %d leaks"), TotalMisses, TotalLeaks);
+	Pools.Empty();
+	PooledProjectiles.Empty();
+	ActiveProjectiles.Empty();
+	Super::Deinitialize();
+}
+
+TStatId UProjectilePoolSubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UProjectilePoolSubsystem, STATGROUP_ProjectilePool);
+}
+
+void UProjectilePoolSubsystem::Tick(float DeltaTime)
+{
+	SCOPE_CYCLE_COUNTER(STAT_ProjectilePoolTick);
+
+	// take back projectiles whose lifetime ran out or whose movement stopped on an impact
+	const double Now = GetWorld()->GetTimeSeconds();
+	for (int32 Index = ActiveProjectiles.Num() - 1; Index >= 0; --Index)
+	{
+		const FActiveProjectile& Entry = ActiveProjectiles[Index];
+		AActor* Projectile = Entry.Projectile.Get();
+		if (Projectile && Entry.ExpireTime > Now)
+		{
+			const UProjectileMovementComponent* Movement = Projectile->FindComponentByClass<UProjectileMovementComponent>();
+			if (!Movement || !Movement->HasStoppedSimulation()) continue;
+		}
+
+		const FPooledProjectileInfo* Info = Projectile ? PooledProjectiles.Find(Projectile) : nullptr;
+		// the projectile may have been released and handed out again since this entry was added
+		const bool bStillSameActivation = Info && Info->bActive && Info->ActivationId == Entry.ActivationId;
+		ActiveProjectiles.RemoveAtSwap(Index, 1, EAllowShrinking::No);
+		if (bStillSameActivation)
+		{
+			Release(Projectile);
+		}
+	}
+	SET_DWORD_STAT(STAT_ProjectilePoolActive, ActiveProjectiles.Num());
+}
+
+void UProjectilePoolSubsystem::Prewarm(TSubclassOf<ABulletBase> BulletClass, int32 Count, float Lifetime)
+{
+	UWorld* World = GetWorld();
+	if (!BulletClass || Count <= 0 || !World || World->GetNetMode() == NM_Client) return;
+
+	FProjectilePool& Pool = Pools.FindOrAdd(BulletClass);
+	Pool.Capacity += Count;
+	if (Pool.Lifetime <= 0.0f)
+	{
+		Pool.Lifetime = Lifetime;
+	}
+	Pool.Free.Reserve(Pool.Capacity);
+	while (Pool.NumInstances < Pool.Capacity)
+	{
+		AActor* Projectile = SpawnPooled(BulletClass, FTransform::Identity, true);
+		if (!Projectile) break;
+		Deactivate(Projectile);
+		Pool.Free.Add(Projectile);
+	}
+}
+
+AActor* UProjectilePoolSubsystem::Acquire(TSubclassOf<ABulletBase> BulletClass, const FTransform& Transform, AActor* NewOwner, float Lifetime)
+{
+	if (!BulletClass) return nullptr;
+
+	FProjectilePool& Pool = Pools.FindOrAdd(BulletClass);
+	AActor* Projectile = nullptr;
+	while (!Projectile && Pool.Free.Num() > 0)
+	{
+		Projectile = Pool.Free.Pop(EAllowShrinking::No);
+		if (!IsValid(Projectile))
+		{
+			Projectile = nullptr;
+		}
+	}
+	if (!Projectile)
+	{
+		++TotalMisses;
+		INC_DWORD_STAT(STAT_ProjectilePoolMisses);
+		Projectile = SpawnPooled(BulletClass, Transform, false);
+		if (!Projectile) return nullptr;
+	}
+
+	Activate(Projectile, Transform, NewOwner);
+	FPooledProjectileInfo& Info = PooledProjectiles.FindChecked(Projectile);
+	// each weapon's own lifetime, several weapons may share the pool of a class
+	const float ActiveLifetime = Lifetime > 0.0f ? Lifetime : Pool.Lifetime > 0.0f ? Pool.Lifetime : 3.0f;
+	ActiveProjectiles.Add({ Projectile, GetWorld()->GetTimeSeconds() + ActiveLifetime, Info.ActivationId });
+	return Projectile;
+}
+
+void UProjectilePoolSubsystem::Release(AActor* Projectile)
+{
+	FPooledProjectileInfo* Info = Projectile ? PooledProjectiles.Find(Projectile) : nullptr;
+	if (!Info)
+	{
+		// not one of ours, fall back to the regular path
+		if (IsValid(Projectile))
+		{
+			Projectile->Destroy();
+		}
+		return;
+	}
+	if (!Info->bActive) return;
+
+	Info->bActive = false;
+	FProjectilePool* Pool = Pools.Find(Info->Class.Get());
+	if (!Pool || Pool->NumInstances > Pool->Capacity)
+	{
+		// grown past its capacity by misses, let the extra instance go
+		PooledProjectiles.Remove(Projectile);
+		Projectile->OnDestroyed.RemoveDynamic(this, &UProjectilePoolSubsystem::OnPooledProjectileDestroyed);
+		if (Pool)
+		{
+			--Pool->NumInstances;
+		}
+		Projectile->Destroy();
+		return;
+	}
+	Deactivate(Projectile);
+	Pool->Free.Add(Projectile);
+}
+
+AActor* UProjectilePoolSubsystem::SpawnPooled(UClass* BulletClass, const FTransform& Transform, bool bInactive)
+{
+	AActor* Projectile = GetWorld()->SpawnActorDeferred<AActor>(BulletClass, Transform, nullptr, nullptr, ESpawnActorCollisionHandlingMethod::AlwaysSpawn);
+	if (!Projectile) return nullptr;
+	if (bInactive)
+	{
+		// prewarmed instances sit at the spawn point until handed out, nothing may hit, tick or move there
+		Projectile->SetActorEnableCollision(false);
+		Projectile->SetActorHiddenInGame(true);
+		Projectile->PrimaryActorTick.bStartWithTickEnabled = false;
+		if (UProjectileMovementComponent* Movement = Projectile->FindComponentByClass<UProjectileMovementComponent>())
+		{
+			Movement->bAutoActivate = false;
+		}
+	}
+	Projectile->FinishSpawning(Transform);
+
+	// the pool owns the lifetime of its projectiles
+	Projectile->SetLifeSpan(0.0f);
+	Projectile->OnDestroyed.AddDynamic(this, &UProjectilePoolSubsystem::OnPooledProjectileDestroyed);
+	FPooledProjectileInfo& Info = PooledProjectiles.Add(Projectile);
+	Info.Class = BulletClass;
+	++Pools.FindOrAdd(BulletClass).NumInstances;
+	return Projectile;
+}
+
+void UProjectilePoolSubsystem::Activate(AActor* Projectile, const FTransform& Transform, AActor* NewOwner)
+{
+	FPooledProjectileInfo& Info = PooledProjectiles.FindChecked(Projectile);
+	Info.bActive = true;
+	++Info.ActivationId;
+
+	Projectile->SetNetDormancy(DORM_Awake);
+	Projectile->SetActorLocationAndRotation(Transform.GetLocation(), Transform.GetRotation(), false, nullptr, ETeleportType::ResetPhysics);
+	Projectile->SetOwner(NewOwner);
+	Projectile->SetActorHiddenInGame(false);
+	Projectile->SetActorEnableCollision(true);
+	Projectile->SetActorTickEnabled(true);
+	if (UProjectileMovementComponent* Movement = Projectile->FindComponentByClass<UProjectileMovementComponent>())
+	{
+		Movement->SetUpdatedComponent(Projectile->GetRootComponent());
+		Movement->Velocity = Transform.GetRotation().GetForwardVector() * Movement->InitialSpeed;
+		Movement->Activate(true);
+	}
+	Projectile->ForceNetUpdate();
+}
+
+void UProjectilePoolSubsystem::Deactivate(AActor* Projectile)
+{
+	if (UProjectileMovementComponent* Movement = Projectile->FindComponentByClass<UProjectileMovementComponent>())
+	{
+		Movement->StopMovementImmediately();
+		Movement->Deactivate();
+	}
+	Projectile->SetActorTickEnabled(false);
+	Projectile->SetActorEnableCollision(false);
+	Projectile->SetActorHiddenInGame(true);
+	// the hidden state still goes out before the channel goes dormant
+	Projectile->SetNetDormancy(DORM_DormantAll);
+}
+
+void UProjectilePoolSubsystem::OnPooledProjectileDestroyed(AActor* DestroyedActor)
+{
+	FPooledProjectileInfo Info;
+	if (!PooledProjectiles.RemoveAndCopyValue(DestroyedActor, Info)) return;
+
+	++TotalLeaks;
+	INC_DWORD_STAT(STAT_ProjectilePoolLeaks);
+	if (FProjectilePool* Pool = Pools.Find(Info.Class.Get()))
+	{
+		--Pool->NumInstances;
+		Pool->Free.Remove(DestroyedActor);
+	}
+}
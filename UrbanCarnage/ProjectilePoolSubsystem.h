@@ -0,0 +1,111 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "ProjectilePoolSubsystem.generated.h"
+
+class ABulletBase;
+
+DECLARE_STATS_GROUP(TEXT("ProjectilePool"), STATGROUP_ProjectilePool, STATCAT_Advanced);
+
+/** Free instances and settings of one projectile class */
+USTRUCT()
+struct FProjectilePool
+{
+	GENERATED_BODY()
+
+	/** Inactive, hidden and dormant projectiles ready to be handed out */
+	UPROPERTY()
+	TArray<TObjectPtr<AActor>> Free;
+
+	/** Number of instances this pool keeps alive, instances released above it are destroyed */
+	int32 Capacity = 0;
+
+	/** Instances currently owned by the pool, free or active */
+	int32 NumInstances = 0;
+
+	/** Seconds an active projectile lives before the pool takes it back, set by the first weapon that prewarms it */
+	float Lifetime = 0.0f;
+};
+
+/**
+ *  Server side pool of projectile actors
+ *  Projectiles are pre-spawned per BulletClass and recycled instead of spawned and destroyed per shot.
+ *  Inactive projectiles are hidden and net dormant, so clients that already have a channel for them keep it
+ *  and the next activation only replicates the new transform. A projectile comes back when it calls Release,
+ *  when its projectile movement stops on an impact, or when its lifetime runs out.
+ */
+UCLASS()
+class URBANCARNAGE_API UProjectilePoolSubsystem : public UTickableWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	// Begin USubsystem interface
+	virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+	virtual void Deinitialize() override;
+	// End USubsystem interface
+
+	// Begin FTickableGameObject interface
+	virtual void Tick(float DeltaTime) override;
+	virtual TStatId GetStatId() const override;
+	// End FTickableGameObject interface
+
+	/** Grows the pool of a class by Count instances and spawns them up front */
+	void Prewarm(TSubclassOf<ABulletBase> BulletClass, int32 Count, float Lifetime);
+
+	/**
+	 * Hands out an active projectile, spawns a new one and counts a miss if the pool is empty.
+	 * @param Lifetime	seconds before the pool takes it back, the pool's lifetime if not positive
+	 */
+	AActor* Acquire(TSubclassOf<ABulletBase> BulletClass, const FTransform& Transform, AActor* NewOwner, float Lifetime = 0.0f);
+
+	/** Returns a projectile to its pool, projectiles that hit something should call this instead of Destroy */
+	UFUNCTION(BlueprintCallable, Category = "Projectile Pool")
+	void Release(AActor* Projectile);
+
+	/** Number of Acquire calls that had to spawn because the pool was empty */
+	UFUNCTION(BlueprintPure, Category = "Projectile Pool")
+	int32 GetTotalMisses() const { return TotalMisses; }
+
+	/** Number of pooled projectiles that were destroyed by someone else instead of released */
+	UFUNCTION(BlueprintPure, Category = "Projectile Pool")
+	int32 GetTotalLeaks() const { return TotalLeaks; }
+
+protected:
+	struct FPooledProjectileInfo
+	{
+		TWeakObjectPtr<UClass> Class;
+		/** Incremented on every activation so stale lifetime entries can be told apart */
+		uint32 ActivationId = 0;
+		bool bActive = false;
+	};
+
+	struct FActiveProjectile
+	{
+		TWeakObjectPtr<AActor> Projectile;
+		double ExpireTime;
+		uint32 ActivationId;
+	};
+
+	/** @param bInactive	spawn without collision, tick and movement, for instances that go straight to the free list */
+	AActor* SpawnPooled(UClass* BulletClass, const FTransform& Transform, bool bInactive);
+	void Activate(AActor* Projectile, const FTransform& Transform, AActor* NewOwner);
+	void Deactivate(AActor* Projectile);
+
+	UFUNCTION()
+	void OnPooledProjectileDestroyed(AActor* DestroyedActor);
+
+	UPROPERTY()
+	TMap<TObjectPtr<UClass>, FProjectilePool> Pools;
+
+	TArray<FActiveProjectile> ActiveProjectiles;
+
+	/** Every projectile owned by the pool */
+	TMap<TWeakObjectPtr<AActor>, FPooledProjectileInfo> PooledProjectiles;
+
+	int32 TotalMisses = 0;
+	int32 TotalLeaks = 0;
+};
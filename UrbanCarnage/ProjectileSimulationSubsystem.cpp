@@ -0,0 +1,188 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "ProjectileSimulationSubsystem.h"
+#include "WeaponBase.h"
+#include "Engine/World.h"
+#include "HAL/IConsoleManager.h"
+
+DECLARE_STATS_GROUP(TEXT("ProjectileSimulation"), STATGROUP_ProjectileSimulation, STATCAT_Advanced);
+DECLARE_CYCLE_STAT(TEXT("Projectile Simulation Tick"), STAT_ProjectileSimulationTick, STATGROUP_ProjectileSimulation);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Simulated Projectiles"), STAT_SimulatedProjectiles, STATGROUP_ProjectileSimulation);
+
+static TAutoConsoleVariable<bool> CVarProjectileAsyncTraces(
+	TEXT("UrbanCarnage.Projectile.AsyncTraces"),
+	true,
+	TEXT("If true, projectile steps are swept async and the projectiles move once the results are read on the next frame."));
+
+bool UProjectileSimulationSubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+	return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+void UProjectileSimulationSubsystem::OnWorldBeginPlay(UWorld& InWorld)
+{
+	Super::OnWorldBeginPlay(InWorld);
+	bPlayCosmetics = InWorld.GetNetMode() != NM_DedicatedServer;
+}
+
+void UProjectileSimulationSubsystem::Deinitialize()
+{
+	Positions.Empty();
+	Velocities.Empty();
+	RemainingLifetimes.Empty();
+	PendingAges.Empty();
+	Radii.Empty();
+	GravityZ.Empty();
+	Weapons.Empty();
+	Authoritative.Empty();
+	TraceHandles.Empty();
+	TraceEnds.Empty();
+	Super::Deinitialize();
+}
+
+TStatId UProjectileSimulationSubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UProjectileSimulationSubsystem, STATGROUP_ProjectileSimulation);
+}
+
+void UProjectileSimulationSubsystem::SpawnProjectile(AWeaponBase* Weapon, const FVector& Origin, const FVector& Direction, bool bAuthoritative, float InitialAge)
+{
+	if (!Weapon) return;
+	Positions.Add(Origin);
+	Velocities.Add(Direction.GetSafeNormal() * Weapon->ProjectileSpeed);
+	RemainingLifetimes.Add(Weapon->ProjectileLifetime);
+	PendingAges.Add(InitialAge);
+	Radii.Add(Weapon->ProjectileRadius);
+	GravityZ.Add(Weapon->ProjectileGravityScale);
+	Weapons.Add(Weapon);
+	Authoritative.Add(bAuthoritative);
+	TraceHandles.AddDefaulted();
+	TraceEnds.Add(Origin);
+}
+
+void UProjectileSimulationSubsystem::RemoveProjectile(int32 Index)
+{
+	Positions.RemoveAtSwap(Index, 1, EAllowShrinking::No);
+	Velocities.RemoveAtSwap(Index, 1, EAllowShrinking::No);
+	RemainingLifetimes.RemoveAtSwap(Index, 1, EAllowShrinking::No);
+	PendingAges.RemoveAtSwap(Index, 1, EAllowShrinking::No);
+	Radii.RemoveAtSwap(Index, 1, EAllowShrinking::No);
+	GravityZ.RemoveAtSwap(Index, 1, EAllowShrinking::No);
+	Weapons.RemoveAtSwap(Index, 1, EAllowShrinking::No);
+	Authoritative.RemoveAtSwap(Index, 1, EAllowShrinking::No);
+	TraceHandles.RemoveAtSwap(Index, 1, EAllowShrinking::No);
+	TraceEnds.RemoveAtSwap(Index, 1, EAllowShrinking::No);
+}
+
+void UProjectileSimulationSubsystem::Tick(float DeltaTime)
+{
+	SCOPE_CYCLE_COUNTER(STAT_ProjectileSimulationTick);
+	SET_DWORD_STAT(STAT_SimulatedProjectiles, Positions.Num());
+	if (Positions.Num() == 0) return;
+
+	// results of last tick's sweeps first, then the next step
+	CollectAsyncResults();
+	StepProjectiles(DeltaTime);
+}
+
+void UProjectileSimulationSubsystem::CollectAsyncResults()
+{
+	UWorld* World = GetWorld();
+	for (int32 Index = Positions.Num() - 1; Index >= 0; --Index)
+	{
+		const FTraceHandle TraceHandle = TraceHandles[Index];
+		if (!TraceHandle.IsValid()) continue;
+
+		FTraceDatum TraceData;
+		if (!World->QueryTraceData(TraceHandle, TraceData))
+		{
+			// not finished yet, the step waits for it
+			if (World->IsTraceHandleValid(TraceHandle, false)) continue;
+			// the result was dropped, count the step as a miss
+			TraceHandles[Index] = FTraceHandle();
+			Positions[Index] = TraceEnds[Index];
+			continue;
+		}
+		TraceHandles[Index] = FTraceHandle();
+
+		const FHitResult* Hit = TraceData.OutHits.FindByPredicate([](const FHitResult& Result) { return Result.bBlockingHit; });
+		if (Hit)
+		{
+			ResolveImpact(Index, *Hit);
+			RemoveProjectile(Index);
+			continue;
+		}
+		Positions[Index] = TraceEnds[Index];
+	}
+}
+
+void UProjectileSimulationSubsystem::StepProjectiles(float DeltaTime)
+{
+	UWorld* World = GetWorld();
+	const float WorldGravityZ = World->GetGravityZ();
+	const bool bAsync = CVarProjectileAsyncTraces.GetValueOnGameThread();
+
+	// iterate backwards so finished projectiles can be swapped out in place
+	for (int32 Index = Positions.Num() - 1; Index >= 0; --Index)
+	{
+		// still waiting for the sweep of the previous step, catch up on the next one
+		if (TraceHandles[Index].IsValid())
+		{
+			PendingAges[Index] += DeltaTime;
+			continue;
+		}
+
+		AWeaponBase* Weapon = Weapons[Index].Get();
+		const float StepTime = DeltaTime + PendingAges[Index];
+		PendingAges[Index] = 0.0f;
+		RemainingLifetimes[Index] -= StepTime;
+		if (!Weapon || RemainingLifetimes[Index] <= 0.0f)
+		{
+			RemoveProjectile(Index);
+			continue;
+		}
+
+		FVector& Velocity = Velocities[Index];
+		Velocity.Z += WorldGravityZ * GravityZ[Index] * StepTime;
+		const FVector Start = Positions[Index];
+		const FVector End = Start + Velocity * StepTime;
+
+		FCollisionQueryParams QueryParams(SCENE_QUERY_STAT(ProjectileSimulation), false);
+		Weapon->AddShooterIgnoredActors(QueryParams);
+		if (bAsync)
+		{
+			TraceHandles[Index] = Radii[Index] > 0.0f
+				? World->AsyncSweepByChannel(EAsyncTraceType::Single, Start, End, FQuat::Identity, Weapon->ProjectileTraceChannel, FCollisionShape::MakeSphere(Radii[Index]), QueryParams)
+				: World->AsyncLineTraceByChannel(EAsyncTraceType::Single, Start, End, Weapon->ProjectileTraceChannel, QueryParams);
+			TraceEnds[Index] = End;
+			continue;
+		}
+
+		FHitResult Hit;
+		const bool bHit = Radii[Index] > 0.0f
+			? World->SweepSingleByChannel(Hit, Start, End, FQuat::Identity, Weapon->ProjectileTraceChannel, FCollisionShape::MakeSphere(Radii[Index]), QueryParams)
+			: World->LineTraceSingleByChannel(Hit, Start, End, Weapon->ProjectileTraceChannel, QueryParams);
+		if (bHit)
+		{
+			ResolveImpact(Index, Hit);
+			RemoveProjectile(Index);
+			continue;
+		}
+		Positions[Index] = End;
+	}
+}
+
+void UProjectileSimulationSubsystem::ResolveImpact(int32 Index, const FHitResult& Hit)
+{
+	AWeaponBase* Weapon = Weapons[Index].Get();
+	if (!Weapon) return;
+	if (Authoritative[Index])
+	{
+		Weapon->ApplyHitDamage(Hit.GetActor(), Weapon->Damage);
+	}
+	if (!Authoritative[Index] || bPlayCosmetics)
+	{
+		Weapon->SimulatedProjectileImpactBP(Hit.ImpactPoint, Hit.ImpactNormal);
+	}
+}
@@ -0,0 +1,70 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "WorldCollision.h"
+#include "ProjectileSimulationSubsystem.generated.h"
+
+class AWeaponBase;
+
+/**
+ *  Lightweight projectile simulation
+ *  Projectiles are plain entries in structure-of-arrays buffers, moved and swept in one pass per tick.
+ *  With async traces a step's sweep is read back on the next tick, the projectile only moves once it is.
+ *  On the server they are authoritative and deal damage, on clients they are cosmetic copies spawned
+ *  from the replicated shot events.
+ */
+UCLASS()
+class URBANCARNAGE_API UProjectileSimulationSubsystem : public UTickableWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	// Begin USubsystem interface
+	virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+	virtual void OnWorldBeginPlay(UWorld& InWorld) override;
+	virtual void Deinitialize() override;
+	// End USubsystem interface
+
+	// Begin FTickableGameObject interface
+	virtual void Tick(float DeltaTime) override;
+	virtual TStatId GetStatId() const override;
+	// End FTickableGameObject interface
+
+	/**
+	 * Adds a projectile fired by Weapon.
+	 * @param bAuthoritative	true on the server, the projectile deals damage on impact
+	 * @param InitialAge		seconds the projectile already travelled, for shots fired between ticks
+	 */
+	void SpawnProjectile(AWeaponBase* Weapon, const FVector& Origin, const FVector& Direction, bool bAuthoritative, float InitialAge = 0.0f);
+
+	int32 GetNumProjectiles() const { return Positions.Num(); }
+
+protected:
+	void RemoveProjectile(int32 Index);
+	/** Collects the sweeps issued last tick, moving the projectiles that missed and resolving the ones that hit */
+	void CollectAsyncResults();
+	/** Advances every projectile without a sweep in flight and sweeps its step, synchronously or async */
+	void StepProjectiles(float DeltaTime);
+	void ResolveImpact(int32 Index, const FHitResult& Hit);
+
+	// one entry per projectile, all arrays share the same index
+	TArray<FVector> Positions;
+	TArray<FVector> Velocities;
+	TArray<float> RemainingLifetimes;
+	/** Time to advance on the first step on top of the frame delta, see SpawnProjectile InitialAge */
+	TArray<float> PendingAges;
+	TArray<float> Radii;
+	TArray<float> GravityZ;
+	TArray<TWeakObjectPtr<AWeaponBase>> Weapons;
+	TArray<bool> Authoritative;
+	/** Async sweep of the current step, invalid if none is in flight */
+	TArray<FTraceHandle> TraceHandles;
+	/** End of the current step, where the projectile moves if its async sweep misses */
+	TArray<FVector> TraceEnds;
+
+	/** True if cosmetic callbacks should run for authoritative projectiles (listen server or standalone) */
+	bool bPlayCosmetics = true;
+};
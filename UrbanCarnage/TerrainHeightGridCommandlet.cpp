@@ -0,0 +1,162 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "TerrainHeightGridCommandlet.h"
+#include "TerrainHeightSubsystem.h"
+#include "Engine/World.h"
+#include "Engine/Level.h"
+#include "Engine/LevelBounds.h"
+#include "Engine/LevelStreaming.h"
+#include "Components/PrimitiveComponent.h"
+#include "HAL/FileManager.h"
+#include "Misc/Paths.h"
+#include "UObject/Package.h"
+
+DEFINE_LOG_CATEGORY_STATIC(LogTerrainHeightGrid, Log, All);
+
+UTerrainHeightGridCommandlet::UTerrainHeightGridCommandlet()
+{
+	IsClient = false;
+	IsEditor = true;
+	IsServer = false;
+	LogToConsole = true;
+}
+
+int32 UTerrainHeightGridCommandlet::Main(const FString& Params)
+{
+	FString MapName;
+	if (!FParse::Value(*Params, TEXT("Map="), MapName))
+	{
+		UE_LOG(LogTerrainHeightGrid, Error, TEXT("Missing -Map=<package name>"));
+		return 1;
+	}
+	float CellSize = 200.0f;
+	float Margin = 5000.0f;
+	FParse::Value(*Params, TEXT("CellSize="), CellSize);
+	FParse::Value(*Params, TEXT("Margin="), Margin);
+	CellSize = FMath::Max(CellSize, 10.0f);
+
+	UPackage* Package = LoadPackage(nullptr, *MapName, LOAD_None);
+	UWorld* World = Package ? UWorld::FindWorldInPackage(Package) : nullptr;
+	if (!World)
+	{
+		UE_LOG(LogTerrainHeightGrid, Error, TEXT("Failed to load map %s"), *MapName);
+		return 1;
+	}
+
+	World->AddToRoot();
+	World->WorldType = EWorldType::Editor;
+	if (!World->bIsWorldInitialized)
+	{
+		World->InitWorld(UWorld::InitializationValues()
+			.AllowAudioPlayback(false)
+			.CreatePhysicsScene(true)
+			.RequiresHitProxies(false)
+			.CreateNavigation(false)
+			.CreateAISystem(false)
+			.ShouldSimulatePhysics(false)
+			.EnableTraceCollision(true)
+			.CreateFXSystem(false));
+	}
+	// bake every streaming level into the grid, the drop can land anywhere
+	for (ULevelStreaming* StreamingLevel : World->GetStreamingLevels())
+	{
+		StreamingLevel->SetShouldBeLoaded(true);
+		StreamingLevel->SetShouldBeVisible(true);
+	}
+	World->FlushLevelStreaming(EFlushLevelStreamingType::Full);
+	World->UpdateWorldComponents(true, false);
+
+	FBox Bounds(ForceInit);
+	for (ULevel* Level : World->GetLevels())
+	{
+		Bounds += ALevelBounds::CalculateLevelBounds(Level);
+	}
+	if (!Bounds.IsValid)
+	{
+		UE_LOG(LogTerrainHeightGrid, Error, TEXT("Map %s has no bounds"), *MapName);
+		World->RemoveFromRoot();
+		return 1;
+	}
+	Bounds = Bounds.ExpandBy(FVector(Margin, Margin, 100.0f));
+
+	FTerrainHeightGridHeader Header;
+	Header.OriginX = Bounds.Min.X;
+	Header.OriginY = Bounds.Min.Y;
+	Header.CellSize = CellSize;
+	Header.SizeX = FMath::CeilToInt32(Bounds.GetSize().X / CellSize) + 1;
+	Header.SizeY = FMath::CeilToInt32(Bounds.GetSize().Y / CellSize) + 1;
+	const int64 NumCells = (int64)Header.SizeX * Header.SizeY;
+	if (NumCells > MAX_int32)
+	{
+		UE_LOG(LogTerrainHeightGrid, Error, TEXT("Grid of %dx%d cells is too large, raise -CellSize"), Header.SizeX, Header.SizeY);
+		World->RemoveFromRoot();
+		return 1;
+	}
+	UE_LOG(LogTerrainHeightGrid, Display, TEXT("Baking %s into %dx%d cells of %.0f"), *MapName, Header.SizeX, Header.SizeY, CellSize);
+
+	TArray<float> Heights;
+	TArray<uint8> Flags;
+	Heights.SetNumZeroed((int32)NumCells);
+	Flags.SetNumZeroed((int32)NumCells);
+
+	// same channel as the runtime ground probes
+	FCollisionQueryParams QueryParams(SCENE_QUERY_STAT(TerrainHeightGrid), false);
+	const FCollisionShape CellColumn = FCollisionShape::MakeBox(FVector(CellSize, CellSize, Bounds.GetExtent().Z));
+	TArray<FOverlapResult> Overlaps;
+	for (int32 Y = 0; Y < Header.SizeY; ++Y)
+	{
+		for (int32 X = 0; X < Header.SizeX; ++X)
+		{
+			const int32 Index = Y * Header.SizeX + X;
+			const double WorldX = Header.OriginX + X * CellSize;
+			const double WorldY = Header.OriginY + Y * CellSize;
+
+			FHitResult Hit;
+			if (World->LineTraceSingleByChannel(Hit, FVector(WorldX, WorldY, Bounds.Max.Z), FVector(WorldX, WorldY, Bounds.Min.Z), ECC_Visibility, QueryParams))
+			{
+				Heights[Index] = Hit.ImpactPoint.Z;
+			}
+			else
+			{
+				Heights[Index] = Bounds.Min.Z;
+				Flags[Index] |= TerrainCell_NoGround;
+			}
+
+			// anything that can move within a cell of this point makes the baked height unreliable
+			Overlaps.Reset();
+			World->OverlapMultiByChannel(Overlaps, FVector(WorldX, WorldY, Bounds.GetCenter().Z), FQuat::Identity, ECC_Visibility, CellColumn, QueryParams);
+			for (const FOverlapResult& Overlap : Overlaps)
+			{
+				const UPrimitiveComponent* Component = Overlap.GetComponent();
+				if (Component && Component->Mobility != EComponentMobility::Static)
+				{
+					Flags[Index] |= TerrainCell_Dynamic;
+					break;
+				}
+			}
+		}
+		if (Y % 64 == 0)
+		{
+			UE_LOG(LogTerrainHeightGrid, Display, TEXT("Row %d / %d"), Y, Header.SizeY);
+		}
+	}
+
+	const FString Path = UTerrainHeightSubsystem::GetGridFilePath(MapName);
+	TUniquePtr<FArchive> Writer(IFileManager::Get().CreateFileWriter(*Path));
+	if (!Writer)
+	{
+		UE_LOG(LogTerrainHeightGrid, Error, TEXT("Failed to write %s"), *Path);
+		World->RemoveFromRoot();
+		return 1;
+	}
+	// raw little endian layout, the subsystem maps it as is
+	Writer->Serialize(&Header, sizeof(Header));
+	Writer->Serialize(Heights.GetData(), Heights.Num() * sizeof(float));
+	Writer->Serialize(Flags.GetData(), Flags.Num() * sizeof(uint8));
+	Writer->Close();
+
+	UE_LOG(LogTerrainHeightGrid, Display, TEXT("Wrote %s"), *Path);
+	World->RemoveFromRoot();
+	return 0;
+}
@@ -0,0 +1,26 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Commandlets/Commandlet.h"
+#include "TerrainHeightGridCommandlet.generated.h"
+
+/**
+ *  Bakes the terrain height grid of a map for UTerrainHeightSubsystem
+ *  Usage: UnrealEditor-Cmd <Project> -run=TerrainHeightGrid -Map=/Game/Maps/MyMap [-CellSize=200] [-Margin=5000]
+ *  Traces every grid point against static geometry and flags the points where movable or dynamic geometry
+ *  is in reach, the runtime falls back to a physics trace there.
+ */
+UCLASS()
+class UTerrainHeightGridCommandlet : public UCommandlet
+{
+	GENERATED_BODY()
+
+public:
+	UTerrainHeightGridCommandlet();
+
+	// Begin UCommandlet interface
+	virtual int32 Main(const FString& Params) override;
+	// End UCommandlet interface
+};
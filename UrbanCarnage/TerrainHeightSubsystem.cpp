@@ -0,0 +1,120 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "TerrainHeightSubsystem.h"
+#include "Engine/World.h"
+#include "HAL/PlatformFileManager.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+
+DEFINE_LOG_CATEGORY_STATIC(LogTerrainHeight, Log, All);
+
+bool UTerrainHeightSubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+	return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+void UTerrainHeightSubsystem::OnWorldBeginPlay(UWorld& InWorld)
+{
+	Super::OnWorldBeginPlay(InWorld);
+	// PIE worlds carry a prefix, the grid is named after the original map
+	LoadGrid(UWorld::RemovePIEPrefix(InWorld.GetOutermost()->GetName()));
+}
+
+void UTerrainHeightSubsystem::Deinitialize()
+{
+	UnloadGrid();
+	Super::Deinitialize();
+}
+
+FString UTerrainHeightSubsystem::GetGridFilePath(const FString& MapName)
+{
+	return FPaths::ProjectContentDir() / TEXT("HeightGrids") / FPaths::GetBaseFilename(MapName) + TEXT(".hgrid");
+}
+
+void UTerrainHeightSubsystem::LoadGrid(const FString& MapName)
+{
+	UnloadGrid();
+	const FString Path = GetGridFilePath(MapName);
+	IPlatformFile& PlatformFile = FPlatformFileManager::Get().GetPlatformFile();
+	if (!PlatformFile.FileExists(*Path))
+	{
+		UE_LOG(LogTerrainHeight, Log, TEXT("No height grid for %s, ground queries use traces"), *MapName);
+		return;
+	}
+
+	const uint8* Data = nullptr;
+	int64 DataSize = 0;
+	FOpenMappedResult MappedResult = PlatformFile.OpenMappedEx(*Path);
+	if (!MappedResult.HasError())
+	{
+		MappedFile = MappedResult.StealValue();
+		MappedRegion.Reset(MappedFile->MapRegion());
+	}
+	if (MappedRegion)
+	{
+		Data = MappedRegion->GetMappedPtr();
+		DataSize = MappedRegion->GetMappedSize();
+	}
+	else if (FFileHelper::LoadFileToArray(LoadedData, *Path))
+	{
+		Data = LoadedData.GetData();
+		DataSize = LoadedData.Num();
+	}
+	if (!Data || DataSize < (int64)sizeof(FTerrainHeightGridHeader))
+	{
+		UE_LOG(LogTerrainHeight, Warning, TEXT("Failed to read height grid %s"), *Path);
+		UnloadGrid();
+		return;
+	}
+
+	FMemory::Memcpy(&Header, Data, sizeof(FTerrainHeightGridHeader));
+	const int64 NumCells = (int64)Header.SizeX * Header.SizeY;
+	const int64 ExpectedSize = sizeof(FTerrainHeightGridHeader) + NumCells * (sizeof(float) + sizeof(uint8));
+	if (Header.Magic != FTerrainHeightGridHeader::ExpectedMagic || Header.Version != FTerrainHeightGridHeader::CurrentVersion
+		|| Header.SizeX < 2 || Header.SizeY < 2 || Header.CellSize <= 0.0f || DataSize < ExpectedSize)
+	{
+		UE_LOG(LogTerrainHeight, Warning, TEXT("Height grid %s is invalid or out of date, regenerate it with the TerrainHeightGrid commandlet"), *Path);
+		UnloadGrid();
+		return;
+	}
+
+	Heights = reinterpret_cast<const float*>(Data + sizeof(FTerrainHeightGridHeader));
+	CellFlags = Data + sizeof(FTerrainHeightGridHeader) + NumCells * sizeof(float);
+	UE_LOG(LogTerrainHeight, Log, TEXT("Loaded height grid %s, %dx%d cells of %.0f"), *Path, Header.SizeX, Header.SizeY, Header.CellSize);
+}
+
+void UTerrainHeightSubsystem::UnloadGrid()
+{
+	Heights = nullptr;
+	CellFlags = nullptr;
+	MappedRegion.Reset();
+	MappedFile.Reset();
+	LoadedData.Empty();
+	Header = FTerrainHeightGridHeader();
+}
+
+bool UTerrainHeightSubsystem::GetGroundHeight(const FVector& Location, float& OutGroundHeight) const
+{
+	if (!Heights) return false;
+
+	const double GridX = (Location.X - Header.OriginX) / Header.CellSize;
+	const double GridY = (Location.Y - Header.OriginY) / Header.CellSize;
+	const int32 X0 = FMath::FloorToInt32(GridX);
+	const int32 Y0 = FMath::FloorToInt32(GridY);
+	if (X0 < 0 || Y0 < 0 || X0 + 1 >= Header.SizeX || Y0 + 1 >= Header.SizeY) return false;
+
+	const int32 Index00 = Y0 * Header.SizeX + X0;
+	const int32 Index10 = Index00 + 1;
+	const int32 Index01 = Index00 + Header.SizeX;
+	const int32 Index11 = Index01 + 1;
+	// any flagged corner means the grid cannot be trusted here
+	if ((CellFlags[Index00] | CellFlags[Index10] | CellFlags[Index01] | CellFlags[Index11]) != 0) return false;
+
+	const float AlphaX = (float)(GridX - X0);
+	const float AlphaY = (float)(GridY - Y0);
+	const float Bottom = FMath::Lerp(Heights[Index00], Heights[Index10], AlphaX);
+	const float Top = FMath::Lerp(Heights[Index01], Heights[Index11], AlphaX);
+	OutGroundHeight = FMath::Lerp(Bottom, Top, AlphaY);
+	return true;
+}
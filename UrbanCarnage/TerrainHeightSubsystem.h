@@ -0,0 +1,79 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "Async/MappedFileHandle.h"
+#include "TerrainHeightSubsystem.generated.h"
+
+/**
+ *  On disk layout of a terrain height grid, written by UTerrainHeightGridCommandlet
+ *  The header is followed by SizeX * SizeY float heights and SizeX * SizeY cell flags, row major in X.
+ */
+struct FTerrainHeightGridHeader
+{
+	static constexpr uint32 ExpectedMagic = 0x48475243; // 'HGRC'
+	static constexpr uint32 CurrentVersion = 1;
+
+	uint32 Magic = ExpectedMagic;
+	uint32 Version = CurrentVersion;
+	double OriginX = 0.0;
+	double OriginY = 0.0;
+	float CellSize = 0.0f;
+	int32 SizeX = 0;
+	int32 SizeY = 0;
+	uint32 Padding = 0;
+};
+
+/** Per cell flags of a terrain height grid */
+enum ETerrainHeightCellFlags : uint8
+{
+	/** Movable or dynamic geometry in or next to the cell, the grid height may be wrong */
+	TerrainCell_Dynamic = 1 << 0,
+	/** Nothing was found below the cell */
+	TerrainCell_NoGround = 1 << 1,
+};
+
+/**
+ *  Answers "how high is the ground here" from a precomputed height grid of the map
+ *  The grid of the current map is memory mapped from Content/HeightGrids/<MapName>.hgrid and sampled
+ *  bilinearly, no physics scene access. Cells near dynamic geometry report that a trace is needed.
+ */
+UCLASS()
+class URBANCARNAGE_API UTerrainHeightSubsystem : public UWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	// Begin USubsystem interface
+	virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+	virtual void OnWorldBeginPlay(UWorld& InWorld) override;
+	virtual void Deinitialize() override;
+	// End USubsystem interface
+
+	/** True if a grid for the current map is loaded */
+	bool HasGrid() const { return Heights != nullptr; }
+
+	/**
+	 * Ground height below a location.
+	 * @return false if there is no grid, the location is outside of it, or the cell is flagged and needs a trace
+	 */
+	bool GetGroundHeight(const FVector& Location, float& OutGroundHeight) const;
+
+	/** Path of the grid file for a map package name */
+	static FString GetGridFilePath(const FString& MapName);
+
+protected:
+	void LoadGrid(const FString& MapName);
+	void UnloadGrid();
+
+	TUniquePtr<IMappedFileHandle> MappedFile;
+	TUniquePtr<IMappedFileRegion> MappedRegion;
+	/** Used instead of the mapping on platforms without memory mapped files */
+	TArray<uint8> LoadedData;
+
+	FTerrainHeightGridHeader Header;
+	const float* Heights = nullptr;
+	const uint8* CellFlags = nullptr;
+};
@@ -1,29 +1,33 @@
-// Copyright Epic Games, Inc. All Rights Reserved.
-
-using UnrealBuildTool;
-
-public class UrbanCarnage : ModuleRules
-{
-	public UrbanCarnage(ReadOnlyTargetRules Target) : base(Target)
-	{
-		PCHUsage = PCHUsageMode.UseExplicitOrSharedPCHs;
-
-		PublicDependencyModuleNames.AddRange(new string[] { 
-			"Core",
-			"CoreUObject",
-			"Engine",
-			"InputCore",
-			"EnhancedInput",
-			"ChaosVehicles",
-			"PhysicsCore",
-			"GameplayAbilities",
-			"GameplayTags",
-			"GameplayTasks",
-			"OnlineSubsystem",
-			"OnlineSubsystemUtils",
-			"VoiceChat"
-		});
-
-		
-	}
-}
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+using UnrealBuildTool;
+
+public class UrbanCarnage : ModuleRules
+{
+	public UrbanCarnage(ReadOnlyTargetRules Target) : base(Target)
+	{
+		PCHUsage = PCHUsageMode.UseExplicitOrSharedPCHs;
+
+		PublicDependencyModuleNames.AddRange(new string[] { 
+			"Core",
+			"CoreUObject",
+			"Engine",
+			"NetCore",
+			"ReplicationGraph",
+			"InputCore",
+			"EnhancedInput",
+			"ChaosVehicles",
+			"Chaos",
+			"PhysicsCore",
+			"SignificanceManager",
+			"GameplayAbilities",
+			"GameplayTags",
+			"GameplayTasks",
+			"OnlineSubsystem",
+			"OnlineSubsystemUtils",
+			"VoiceChat"
+		});
+
+		
+	}
+}
@@ -1,7 +1,7 @@
-// Copyright Epic Games, Inc. All Rights Reserved.
-
-#include "UrbanCarnage.h"
-#include "Modules/ModuleManager.h"
-
-IMPLEMENT_PRIMARY_GAME_MODULE( FDefaultGameModuleImpl, UrbanCarnage, "UrbanCarnage" );
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "UrbanCarnage.h"
+#include "Modules/ModuleManager.h"
+
+IMPLEMENT_PRIMARY_GAME_MODULE( FDefaultGameModuleImpl, UrbanCarnage, "UrbanCarnage" );
  
\ No newline at end of file
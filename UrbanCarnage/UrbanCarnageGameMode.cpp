@@ -1,9 +1,9 @@
-// Copyright Epic Games, Inc. All Rights Reserved.
-
-#include "UrbanCarnageGameMode.h"
-#include "UrbanCarnagePlayerController.h"
-
-AUrbanCarnageGameMode::AUrbanCarnageGameMode()
-{
-	PlayerControllerClass = AUrbanCarnagePlayerController::StaticClass();
-}
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "UrbanCarnageGameMode.h"
+#include "UrbanCarnagePlayerController.h"
+
+AUrbanCarnageGameMode::AUrbanCarnageGameMode()
+{
+	PlayerControllerClass = AUrbanCarnagePlayerController::StaticClass();
+}
@@ -1,19 +1,19 @@
-// Copyright Epic Games, Inc. All Rights Reserved.
-
-#pragma once
-
-#include "CoreMinimal.h"
-#include "GameFramework/GameModeBase.h"
-#include "UrbanCarnageGameMode.generated.h"
-
-UCLASS(MinimalAPI)
-class AUrbanCarnageGameMode : public AGameModeBase
-{
-	GENERATED_BODY()
-
-public:
-	AUrbanCarnageGameMode();
-};
-
-
-
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "GameFramework/GameModeBase.h"
+#include "UrbanCarnageGameMode.generated.h"
+
+UCLASS(MinimalAPI)
+class AUrbanCarnageGameMode : public AGameModeBase
+{
+	GENERATED_BODY()
+
+public:
+	AUrbanCarnageGameMode();
+};
+
+
+
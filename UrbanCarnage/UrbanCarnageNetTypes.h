@@ -0,0 +1,261 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Engine/NetSerialization.h"
+#include "UrbanCarnageNetTypes.generated.h"
+
+/**
+ *  Compact aim sample sent from the owning client to the server.
+ *  Yaw and pitch are 16-bit fixed point angles of the aim direction from the vehicle origin,
+ *  the range is a square-root bucket so close targets keep more precision than far ones.
+ */
+USTRUCT()
+struct FQuantizedAim
+{
+	GENERATED_BODY()
+
+	UPROPERTY()
+	uint16 Yaw = 0;
+
+	UPROPERTY()
+	uint16 Pitch = 0;
+
+	UPROPERTY()
+	uint8 RangeBucket = 0;
+
+	/** Builds a sample from an offset (aim point - vehicle origin) */
+	static FQuantizedAim Quantize(const FVector& Offset, float MaxRange)
+	{
+		FQuantizedAim Result;
+		const FRotator Rotation = Offset.Rotation();
+		Result.Yaw = FRotator::CompressAxisToShort(Rotation.Yaw);
+		Result.Pitch = FRotator::CompressAxisToShort(Rotation.Pitch);
+		const float Alpha = MaxRange > 0.0f ? FMath::Clamp(Offset.Size() / MaxRange, 0.0f, 1.0f) : 0.0f;
+		Result.RangeBucket = (uint8)FMath::RoundToInt(FMath::Sqrt(Alpha) * 255.0f);
+		return Result;
+	}
+
+	FVector GetDirection() const
+	{
+		return FRotator(FRotator::DecompressAxisFromShort(Pitch), FRotator::DecompressAxisFromShort(Yaw), 0.0f).Vector();
+	}
+
+	float GetRange(float MaxRange) const
+	{
+		const float Alpha = RangeBucket / 255.0f;
+		return Alpha * Alpha * MaxRange;
+	}
+};
+
+/**
+ *  Vehicle input packed into 4 bytes, sent by the owning client once per frame when it changed.
+ *  Axes are stored as 8-bit fixed point, handbrake and parachute as flags.
+ */
+USTRUCT()
+struct FPackedVehicleInput
+{
+	GENERATED_BODY()
+
+	enum EFlags : uint8
+	{
+		Flag_Handbrake = 1 << 0,
+		Flag_Parachute = 1 << 1,
+	};
+
+	UPROPERTY()
+	int8 Steering = 0;
+
+	UPROPERTY()
+	int8 Throttle = 0;
+
+	UPROPERTY()
+	uint8 Brake = 0;
+
+	UPROPERTY()
+	uint8 Flags = 0;
+
+	static int8 PackAxis(float Value) { return (int8)FMath::RoundToInt(FMath::Clamp(Value, -1.0f, 1.0f) * 127.0f); }
+	static float UnpackAxis(int8 Value) { return Value / 127.0f; }
+
+	void SetSteering(float Value) { Steering = PackAxis(Value); }
+	void SetThrottle(float Value) { Throttle = PackAxis(Value); }
+	void SetBrake(float Value) { Brake = (uint8)FMath::RoundToInt(FMath::Clamp(Value, 0.0f, 1.0f) * 255.0f); }
+	void SetFlag(EFlags Flag, bool bSet) { Flags = bSet ? (Flags | Flag) : (Flags & ~Flag); }
+
+	float GetSteering() const { return UnpackAxis(Steering); }
+	float GetThrottle() const { return UnpackAxis(Throttle); }
+	float GetBrake() const { return Brake / 255.0f; }
+	bool HasFlag(EFlags Flag) const { return (Flags & Flag) != 0; }
+
+	bool operator==(const FPackedVehicleInput& Other) const
+	{
+		return Steering == Other.Steering && Throttle == Other.Throttle && Brake == Other.Brake && Flags == Other.Flags;
+	}
+	bool operator!=(const FPackedVehicleInput& Other) const { return !(*this == Other); }
+};
+
+/**
+ *  Replicated turret/cannon aim of a weapon.
+ *  Angles are 16-bit fixed point world yaw/pitch, the timestamp is server time in milliseconds
+ *  and wraps every ~65 seconds, receivers unwrap it against the previous sample.
+ */
+USTRUCT()
+struct FCompressedWeaponAim
+{
+	GENERATED_BODY()
+
+	UPROPERTY()
+	uint16 TurretYaw = 0;
+
+	UPROPERTY()
+	uint16 CannonPitch = 0;
+
+	UPROPERTY()
+	uint16 Timestamp = 0;
+
+	static uint16 CompressTime(double TimeSeconds) { return (uint16)((uint64)(TimeSeconds * 1000.0) & 0xFFFF); }
+
+	/** Milliseconds from an older wrapped timestamp to this one */
+	int32 GetDeltaMs(uint16 OlderTimestamp) const { return (int32)(uint16)(Timestamp - OlderTimestamp); }
+
+	float GetTurretYaw() const { return FRotator::DecompressAxisFromShort(TurretYaw); }
+	float GetCannonPitch() const { return FRotator::NormalizeAxis(FRotator::DecompressAxisFromShort(CannonPitch)); }
+
+	bool HasSameAngles(const FCompressedWeaponAim& Other) const
+	{
+		return TurretYaw == Other.TurretYaw && CannonPitch == Other.CannonPitch;
+	}
+};
+
+/**
+ *  One shot fired by a simulated-projectile or hitscan weapon.
+ *  The server groups all shots of a vehicle in a frame into one multicast, clients rebuild the shot
+ *  direction from the seed and simulate the cosmetic projectile locally.
+ */
+USTRUCT()
+struct FShotFiredEvent
+{
+	GENERATED_BODY()
+
+	UPROPERTY()
+	FVector_NetQuantize Origin;
+
+	UPROPERTY()
+	FVector_NetQuantizeNormal Direction;
+
+	/** Seed for the shot spread */
+	UPROPERTY()
+	uint16 Seed = 0;
+
+	/** Weapon slot on the firing vehicle, see AUrbanCarnagePawn::GetWeaponInSlot */
+	UPROPERTY()
+	uint8 WeaponSlot = 0;
+};
+
+/** A shot the owning client already played, sent to the server to be fired for real */
+USTRUCT()
+struct FPredictedShot
+{
+	GENERATED_BODY()
+
+	UPROPERTY()
+	FShotFiredEvent Shot;
+
+	/** Wrapping sequence number of the shot, the server acknowledges shots by it */
+	UPROPERTY()
+	uint16 Sequence = 0;
+};
+
+/** Cosmetic effects sent to clients through UCosmeticEventSubsystem */
+UENUM()
+enum class ECosmeticEventType : uint8
+{
+	DeployStart,
+	DeployStop,
+	ParachuteOpen,
+	ParachuteStop,
+	Destroyed,
+	/** Muzzle effect of a projectile actor weapon, one per weapon and flush however many shots it fired */
+	WeaponFired,
+};
+
+/** One cosmetic effect played by a vehicle or one of its weapons */
+USTRUCT()
+struct FCosmeticEvent
+{
+	GENERATED_BODY()
+
+	/** The vehicle, weapon events name the weapon by slot so they also work for weapons without a channel */
+	UPROPERTY()
+	TObjectPtr<AActor> Source;
+
+	UPROPERTY()
+	ECosmeticEventType Type = ECosmeticEventType::DeployStart;
+
+	/** Weapon slot of WeaponFired */
+	UPROPERTY()
+	uint8 Param = 0;
+};
+
+/**
+ *  Replicated movement state of a vehicle, sent to simulated proxies in place of ReplicatedMovement.
+ *  Serialized as one unit: location to 0.1cm, rotation as 16-bit angles, velocities to 1 unit/s,
+ *  the packed driver input and a wrapping millisecond server timestamp like FCompressedWeaponAim.
+ */
+USTRUCT()
+struct FVehicleSnapshot
+{
+	GENERATED_BODY()
+
+	UPROPERTY()
+	FVector_NetQuantize10 Location;
+
+	UPROPERTY()
+	FRotator Rotation = FRotator::ZeroRotator;
+
+	UPROPERTY()
+	FVector_NetQuantize LinearVelocity;
+
+	/** Degrees per second, like FRepMovement */
+	UPROPERTY()
+	FVector_NetQuantize AngularVelocity;
+
+	/** Steering, throttle, brake and handbrake as the server's movement component sees them */
+	UPROPERTY()
+	FPackedVehicleInput Input;
+
+	UPROPERTY()
+	uint16 Timestamp = 0;
+
+	static uint16 CompressTime(double TimeSeconds) { return (uint16)((uint64)(TimeSeconds * 1000.0) & 0xFFFF); }
+
+	/** Milliseconds from an older wrapped timestamp to this one */
+	int32 GetDeltaMs(uint16 OlderTimestamp) const { return (int32)(uint16)(Timestamp - OlderTimestamp); }
+
+	bool NetSerialize(FArchive& Ar, UPackageMap* Map, bool& bOutSuccess)
+	{
+		bOutSuccess = true;
+		bool bFieldSuccess = true;
+		Location.NetSerialize(Ar, Map, bFieldSuccess);
+		bOutSuccess &= bFieldSuccess;
+		Rotation.SerializeCompressedShort(Ar);
+		LinearVelocity.NetSerialize(Ar, Map, bFieldSuccess);
+		bOutSuccess &= bFieldSuccess;
+		AngularVelocity.NetSerialize(Ar, Map, bFieldSuccess);
+		bOutSuccess &= bFieldSuccess;
+		Ar << Input.Steering << Input.Throttle << Input.Brake << Input.Flags;
+		Ar << Timestamp;
+		return true;
+	}
+};
+
+template<>
+struct TStructOpsTypeTraits<FVehicleSnapshot> : public TStructOpsTypeTraitsBase2<FVehicleSnapshot>
+{
+	enum
+	{
+		WithNetSerializer = true,
+	};
+};
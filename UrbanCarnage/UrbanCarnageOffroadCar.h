@@ -1,40 +1,40 @@
-// Copyright Epic Games, Inc. All Rights Reserved.
-
-#pragma once
-
-#include "CoreMinimal.h"
-#include "UrbanCarnagePawn.h"
-#include "UrbanCarnageOffroadCar.generated.h"
-
-/**
- *  Offroad car wheeled vehicle implementation
- */
-UCLASS(abstract)
-class URBANCARNAGE_API AUrbanCarnageOffroadCar : public AUrbanCarnagePawn
-{
-	GENERATED_BODY()
-	
-	/** Chassis static mesh */
-	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = Meshes, meta = (AllowPrivateAccess = "true"))
-	UStaticMeshComponent* Chassis;
-
-	/** FL Tire static mesh */
-	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = Meshes, meta = (AllowPrivateAccess = "true"))
-	UStaticMeshComponent* TireFrontLeft;
-
-	/** FR Tire static mesh */
-	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = Meshes, meta = (AllowPrivateAccess = "true"))
-	UStaticMeshComponent* TireFrontRight;
-
-	/** RL Tire static mesh */
-	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = Meshes, meta = (AllowPrivateAccess = "true"))
-	UStaticMeshComponent* TireRearLeft;
-
-	/** RR Tire static mesh */
-	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = Meshes, meta = (AllowPrivateAccess = "true"))
-	UStaticMeshComponent* TireRearRight;
-
-public:
-
-	AUrbanCarnageOffroadCar();
-};
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "UrbanCarnagePawn.h"
+#include "UrbanCarnageOffroadCar.generated.h"
+
+/**
+ *  Offroad car wheeled vehicle implementation
+ */
+UCLASS(abstract)
+class URBANCARNAGE_API AUrbanCarnageOffroadCar : public AUrbanCarnagePawn
+{
+	GENERATED_BODY()
+	
+	/** Chassis static mesh */
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = Meshes, meta = (AllowPrivateAccess = "true"))
+	UStaticMeshComponent* Chassis;
+
+	/** FL Tire static mesh */
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = Meshes, meta = (AllowPrivateAccess = "true"))
+	UStaticMeshComponent* TireFrontLeft;
+
+	/** FR Tire static mesh */
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = Meshes, meta = (AllowPrivateAccess = "true"))
+	UStaticMeshComponent* TireFrontRight;
+
+	/** RL Tire static mesh */
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = Meshes, meta = (AllowPrivateAccess = "true"))
+	UStaticMeshComponent* TireRearLeft;
+
+	/** RR Tire static mesh */
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = Meshes, meta = (AllowPrivateAccess = "true"))
+	UStaticMeshComponent* TireRearRight;
+
+public:
+
+	AUrbanCarnageOffroadCar();
+};
@@ -1,19 +1,19 @@
-// Copyright Epic Games, Inc. All Rights Reserved.
-
-#pragma once
-
-#include "CoreMinimal.h"
-#include "UrbanCarnageWheelFront.h"
-#include "UrbanCarnageOffroadWheelFront.generated.h"
-
-/**
- *  Front wheel definition for Offroad Car.
- */
-UCLASS()
-class URBANCARNAGE_API UUrbanCarnageOffroadWheelFront : public UUrbanCarnageWheelFront
-{
-	GENERATED_BODY()
-	
-public:
-	UUrbanCarnageOffroadWheelFront();
-};
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "UrbanCarnageWheelFront.h"
+#include "UrbanCarnageOffroadWheelFront.generated.h"
+
+/**
+ *  Front wheel definition for Offroad Car.
+ */
+UCLASS()
+class URBANCARNAGE_API UUrbanCarnageOffroadWheelFront : public UUrbanCarnageWheelFront
+{
+	GENERATED_BODY()
+	
+public:
+	UUrbanCarnageOffroadWheelFront();
+};
@@ -0,0 +1,9 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+
+#include "UrbanCarnageOffroadWheelFrontRaycast.h"
+
+UUrbanCarnageOffroadWheelFrontRaycast::UUrbanCarnageOffroadWheelFrontRaycast()
+{
+	SweepShape = ESweepShape::Raycast;
+}
@@ -0,0 +1,19 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "UrbanCarnageOffroadWheelFront.h"
+#include "UrbanCarnageOffroadWheelFrontRaycast.generated.h"
+
+/**
+ *  Front wheel for Offroad Car at reduced simulation LOD, raycast instead of shapecast.
+ */
+UCLASS()
+class URBANCARNAGE_API UUrbanCarnageOffroadWheelFrontRaycast : public UUrbanCarnageOffroadWheelFront
+{
+	GENERATED_BODY()
+	
+public:
+	UUrbanCarnageOffroadWheelFrontRaycast();
+};
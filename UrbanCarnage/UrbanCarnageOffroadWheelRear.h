@@ -1,20 +1,20 @@
-// Copyright Epic Games, Inc. All Rights Reserved.
-
-#pragma once
-
-#include "CoreMinimal.h"
-#include "UrbanCarnageWheelRear.h"
-#include "UrbanCarnageOffroadWheelRear.generated.h"
-
-/**
- *  Rear wheel definition for Offroad Car.
- */
-UCLASS()
-class URBANCARNAGE_API UUrbanCarnageOffroadWheelRear : public UUrbanCarnageWheelRear
-{
-	GENERATED_BODY()
-	
-public:
-
-	UUrbanCarnageOffroadWheelRear();
-};
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "UrbanCarnageWheelRear.h"
+#include "UrbanCarnageOffroadWheelRear.generated.h"
+
+/**
+ *  Rear wheel definition for Offroad Car.
+ */
+UCLASS()
+class URBANCARNAGE_API UUrbanCarnageOffroadWheelRear : public UUrbanCarnageWheelRear
+{
+	GENERATED_BODY()
+	
+public:
+
+	UUrbanCarnageOffroadWheelRear();
+};
@@ -0,0 +1,9 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+
+#include "UrbanCarnageOffroadWheelRearRaycast.h"
+
+UUrbanCarnageOffroadWheelRearRaycast::UUrbanCarnageOffroadWheelRearRaycast()
+{
+	SweepShape = ESweepShape::Raycast;
+}
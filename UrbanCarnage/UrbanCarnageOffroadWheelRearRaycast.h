@@ -0,0 +1,19 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "UrbanCarnageOffroadWheelRear.h"
+#include "UrbanCarnageOffroadWheelRearRaycast.generated.h"
+
+/**
+ *  Rear wheel for Offroad Car at reduced simulation LOD, raycast instead of shapecast.
+ */
+UCLASS()
+class URBANCARNAGE_API UUrbanCarnageOffroadWheelRearRaycast : public UUrbanCarnageOffroadWheelRear
+{
+	GENERATED_BODY()
+	
+public:
+	UUrbanCarnageOffroadWheelRearRaycast();
+};
@@ -1,555 +1,1211 @@
-// Copyright Epic Games, Inc. All Rights Reserved.
-
-#include "UrbanCarnagePawn.h"
-
-#include "AbilitySystemBlueprintLibrary.h"
-#include "AbilitySystemComponent.h"
-#include "UrbanCarnageWheelFront.h"
-#include "UrbanCarnageWheelRear.h"
-#include "Components/SkeletalMeshComponent.h"
-#include "GameFramework/SpringArmComponent.h"
-#include "Camera/CameraComponent.h"
-#include "EnhancedInputComponent.h"
-#include "EnhancedInputSubsystems.h"
-#include "InputActionValue.h"
-#include "ChaosWheeledVehicleMovementComponent.h"
-#include "UrbanCarnagePlayerController.h"
-#include "Components/ArrowComponent.h"
-#include "Net/UnrealNetwork.h"
-#include "Particles/ParticleSystemComponent.h"
-
-#define LOCTEXT_NAMESPACE "VehiclePawn"
-
-DEFINE_LOG_CATEGORY(LogTemplateVehicle);
-
-AUrbanCarnagePawn::AUrbanCarnagePawn()
-{
-
-
-	// construct the back camera boom
-	BackSpringArm = CreateDefaultSubobject<USpringArmComponent>(TEXT("Back Spring Arm"));
-	BackSpringArm->SetupAttachment(GetMesh());
-	BackSpringArm->TargetArmLength = 650.0f;
-	BackSpringArm->SocketOffset.Z = 150.0f;
-	BackSpringArm->bDoCollisionTest = false;
-	BackSpringArm->bInheritPitch = false;
-	BackSpringArm->bInheritRoll = false;
-	BackSpringArm->bEnableCameraRotationLag = true;
-	BackSpringArm->CameraRotationLagSpeed = 2.0f;
-	BackSpringArm->CameraLagMaxDistance = 50.0f;
-
-	BackCamera = CreateDefaultSubobject<UCameraComponent>(TEXT("Back Camera"));
-	BackCamera->SetupAttachment(BackSpringArm);
-
-	AbilitySystemComponent=CreateDefaultSubobject<UAbilitySystemComponent>(TEXT("AbilitySystemComponent"));
-	
-	// Configure the car mesh
-	GetMesh()->SetSimulatePhysics(true);
-	GetMesh()->SetCollisionProfileName(FName("Vehicle"));
-
-	// get the Chaos Wheeled movement component
-	ChaosVehicleMovement = CastChecked<UChaosWheeledVehicleMovementComponent>(GetVehicleMovement());
-
-	PrimaryWeaponSlot = CreateDefaultSubobject<USceneComponent>(TEXT("PrimaryWeaponSlot"));
-	PrimaryWeaponSlot->SetupAttachment(GetMesh());
-	SecondaryWeaponSlot1 = CreateDefaultSubobject<USceneComponent>(TEXT("SecondaryWeaponSlot1"));
-	SecondaryWeaponSlot1->SetupAttachment(GetMesh());
-	SecondaryWeaponSlot2 = CreateDefaultSubobject<USceneComponent>(TEXT("SecondaryWeaponSlot2"));
-	SecondaryWeaponSlot2->SetupAttachment(GetMesh());
-	
-	
-}
-
-void AUrbanCarnagePawn::GetLifetimeReplicatedProps(TArray<class FLifetimeProperty>& OutLifetimeProps) const
-{
-	Super::GetLifetimeReplicatedProps(OutLifetimeProps);
-	DOREPLIFETIME(AUrbanCarnagePawn,bIsInAir);
-	DOREPLIFETIME(AUrbanCarnagePawn,AirSpeedMultiplier);
-	DOREPLIFETIME(AUrbanCarnagePawn,AirTurnMultipler);
-	DOREPLIFETIME(AUrbanCarnagePawn,IsParachuting);
-	DOREPLIFETIME(AUrbanCarnagePawn,PrimaryWeapon_Ref)
-	DOREPLIFETIME(AUrbanCarnagePawn,SecondaryWeapon_Ref1)
-	DOREPLIFETIME(AUrbanCarnagePawn,SecondaryWeapon_Ref2)
-	DOREPLIFETIME(AUrbanCarnagePawn,AimPoint);
-	
-}
-
-
-void AUrbanCarnagePawn::SetupPlayerInputComponent(class UInputComponent* PlayerInputComponent)
-{
-	Super::SetupPlayerInputComponent(PlayerInputComponent);
-
-	if (UEnhancedInputComponent* EnhancedInputComponent = Cast<UEnhancedInputComponent>(PlayerInputComponent))
-	{
-		// steering
-		EnhancedInputComponent->BindAction(SteeringAction, ETriggerEvent::Triggered, this, &AUrbanCarnagePawn::Steering);
-		EnhancedInputComponent->BindAction(SteeringAction, ETriggerEvent::Completed, this, &AUrbanCarnagePawn::Steering);
-
-		// throttle 
-		EnhancedInputComponent->BindAction(ThrottleAction, ETriggerEvent::Triggered, this, &AUrbanCarnagePawn::Throttle);
-		EnhancedInputComponent->BindAction(ThrottleAction, ETriggerEvent::Completed, this, &AUrbanCarnagePawn::Throttle);
-
-		// break 
-		EnhancedInputComponent->BindAction(BrakeAction, ETriggerEvent::Triggered, this, &AUrbanCarnagePawn::Brake);
-		EnhancedInputComponent->BindAction(BrakeAction, ETriggerEvent::Started, this, &AUrbanCarnagePawn::StartBrake);
-		EnhancedInputComponent->BindAction(BrakeAction, ETriggerEvent::Completed, this, &AUrbanCarnagePawn::StopBrake);
-
-		// handbrake 
-		EnhancedInputComponent->BindAction(HandbrakeAction, ETriggerEvent::Started, this, &AUrbanCarnagePawn::StartHandbrake);
-		EnhancedInputComponent->BindAction(HandbrakeAction, ETriggerEvent::Completed, this, &AUrbanCarnagePawn::StopHandbrake);
-
-		// look around 
-		EnhancedInputComponent->BindAction(LookAroundAction, ETriggerEvent::Triggered, this, &AUrbanCarnagePawn::LookAround);
-		
-		// reset the vehicle 
-		EnhancedInputComponent->BindAction(ResetVehicleAction, ETriggerEvent::Triggered, this, &AUrbanCarnagePawn::ResetVehicle);
-		// Fire
-		EnhancedInputComponent->BindAction(FireAction, ETriggerEvent::Triggered, this, &AUrbanCarnagePawn::Fire);
-	}
-	else
-	{
-		UE_LOG(LogTemplateVehicle, Error, TEXT("'%s' Failed to find an Enhanced Input component! This template is built to use the Enhanced Input system. If you intend to use the legacy system, then you will need to update this C++ file."), *GetNameSafe(this));
-	}
-}
-
-
-void AUrbanCarnagePawn::Fire(const FInputActionValue& Value)
-{
-	// call the server fire function
-	if (IsLocallyControlled())
-	{
-		Server_Fire();
-	}
-}
-
-void AUrbanCarnagePawn::SetDeployMode(bool bDeploy)
-{
-	bIsInAir=bDeploy;
-	DeployEffect_MC(bIsInAir);
-	if (!bIsInAir) OpenParachutEffect_MC(false);
-	GetMesh()->SetEnableGravity(!bDeploy);
-	GetMesh()->SetLinearDamping(bIsInAir?1.0f:0.1f);
-	GetMesh()->SetAngularDamping(bIsInAir?1.0f:0.1f);
-	
-}
-
-void AUrbanCarnagePawn::CheckForGround()
-{
-	//linetrace down to check if we are on ground or not 1000 units
-	FVector StartLocation = GetActorLocation();
-	FVector EndLocation = StartLocation - FVector(0,0,1000);
-	FHitResult HitResult;
-	FCollisionQueryParams CollisionParams;
-	CollisionParams.AddIgnoredActor(this);
-	bool bHit = GetWorld()->LineTraceSingleByChannel(HitResult, StartLocation, EndLocation, ECC_Visibility, CollisionParams);
-	if (bHit)
-	{
-		bIsInAir=false;
-		GetMesh()->SetEnableGravity(true);
-		GetMesh()->SetLinearDamping(0.1f);
-		GetMesh()->SetAngularDamping(0.1f);
-		DeployEffect_MC(false);
-		OpenParachutEffect_MC(false);
-	}
-	else
-	{
-		bIsInAir=true;
-	}
-}
-
-void AUrbanCarnagePawn::OpenParachutEffect_MC_Implementation(bool Start)
-{
-	if (Start)
-	{
-		OpenParachutEffect_BP();
-	}
-	else
-	{
-		StopParachutEffect_BP();
-	}
-}
-
-void AUrbanCarnagePawn::DeployEffect_MC_Implementation(bool Start)
-{
-	if (Start)
-	{
-		deployEffect_BP();
-	}
-	else
-	{
-		StopDeployEffect_BP();
-	}
-	
-}
-
-void AUrbanCarnagePawn::CalculateAimLocation()
-{
-	if (!IsLocallyControlled()) return;
-	FVector StartLocation = BackCamera->GetComponentLocation();
-	FVector EndLocation = StartLocation + (BackCamera->GetForwardVector() * 90000.0f);
-
-	FHitResult HitResult;
-	FCollisionQueryParams CollisionParams;
-	CollisionParams.AddIgnoredActor(this);
-	bool bHit = GetWorld()->LineTraceSingleByChannel(HitResult, StartLocation, EndLocation, ECC_Visibility, CollisionParams);
-	if (bHit)
-	{
-		AimPoint = HitResult.ImpactPoint;	
-	}
-	else
-	{
-		AimPoint = EndLocation;
-	}
-	
-	Server_SetAimLocation(AimPoint);
-	
-}
-
-void AUrbanCarnagePawn::Death()
-{
-	if (isDead) return;
-	if (HasAuthority())
-	{
-		
-		DestroyEffect_MC();
-		//launch car upwards and add random touqe
-		GetMesh()->AddImpulse(FVector(0,0,6000));
-		GetMesh()->AddTorqueInRadians(FVector(FMath::RandRange(-500,500),FMath::RandRange(-500,500),FMath::RandRange(-500,500)),"None",true);
-		//Destroy();
-		isDead=true;
-		//unpossess
-		AController* _Controller = GetController();
-		if (_Controller)
-		{
-			_Controller->UnPossess();
-		}
-	}
-		
-	/*if (AbilitySystemComponent)
-	{
-	    FGameplayTag DeathAbilityTag = FGameplayTag::RequestGameplayTag(FName("Ability.Death"));
-	    bool HasAbility = AbilitySystemComponent->HasMatchingGameplayTag(DeathAbilityTag);
-	    GEngine->AddOnScreenDebugMessage(-1, 5.f, FColor::Green, FString::Printf(TEXT("Has Ability with tag 'Ability.Death': %d"), HasAbility));
-		//activate
-			    bool CanDo= AbilitySystemComponent->TryActivateAbilitiesByTag(FGameplayTagContainer(DeathAbilityTag));
-	    //print can do to screen
-	    if (GEngine)
-	    {
-	        GEngine->AddOnScreenDebugMessage(89, 2.0f, FColor::Red, FString::Printf(TEXT("Can do: %d"), CanDo));
-	    }
-	}*/
-}
-
-void AUrbanCarnagePawn::Destroyed()
-{
-	Super::Destroyed();
-	if (!HasAuthority())return;
-	//destroy all weapons
-	if (PrimaryWeapon_Ref)
-	{
-		PrimaryWeapon_Ref->Destroy();
-	}
-	if (SecondaryWeapon_Ref1)
-	{
-		SecondaryWeapon_Ref1->Destroy();
-	}
-	if (SecondaryWeapon_Ref2)
-	{
-		SecondaryWeapon_Ref2->Destroy();
-	}
-	
-}
-
-void AUrbanCarnagePawn::DestroyEffect_MC_Implementation()
-{
-	DestroyEffect_BP();
-}
-
-void AUrbanCarnagePawn::Server_SetAimLocation_Implementation(FVector _AimPoint)
-{
-	AimPoint=_AimPoint;
-	if (PrimaryWeapon_Ref)
-		PrimaryWeapon_Ref->Aim(AimPoint);
-	if (SecondaryWeapon_Ref1)
-		SecondaryWeapon_Ref1->Aim(AimPoint);
-	if (SecondaryWeapon_Ref2)
-		SecondaryWeapon_Ref2->Aim(AimPoint);
-}
-
-void AUrbanCarnagePawn::Server_SetParachuting_Implementation(bool bParachuting)
-{
-	if (!bIsInAir) return;
-	IsParachuting=bParachuting;
-	if (IsParachuting)
-	{
-		OpenParachutEffect_MC(true);
-	}
-}
-
-void AUrbanCarnagePawn::Server_Fire_Implementation()
-{
-
-	if (HasAuthority())
-	{
-		//call shoot function of weaponbase
-		if (PrimaryWeapon_Ref)
-		{
-			PrimaryWeapon_Ref->Shoot();
-		}
-		if (SecondaryWeapon_Ref1)
-		{
-			SecondaryWeapon_Ref1->Shoot();
-		}
-		if (SecondaryWeapon_Ref2)
-		{
-			SecondaryWeapon_Ref2->Shoot();
-		}
-	}
-}
-
-void AUrbanCarnagePawn::Tick(float Delta)
-{
-	Super::Tick(Delta);
-	
-	// add some angular damping if the vehicle is in midair
-	bool bMovingOnGround = ChaosVehicleMovement->IsMovingOnGround();
-	GetMesh()->SetAngularDamping(bMovingOnGround ? 0.0f : 3.0f);
-
-	/*// realign the camera yaw to face front
-	float CameraYaw = BackSpringArm->GetRelativeRotation().Yaw;
-	CameraYaw = FMath::FInterpTo(CameraYaw, 0.0f, Delta, 1.0f);
-
-	BackSpringArm->SetRelativeRotation(FRotator(0.0f, CameraYaw, 0.0f));*/
-
-	
-	//in air controls---------------------------
-	if (HasAuthority()&&bIsInAir)
-	{
-		//Add Force Forward where actor face but only forward world not if it looks down
-		FVector ForwardVector = GetActorForwardVector();
-		ForwardVector.Z = 0; // Zero out the Z component to ensure the force is only applied in the horizontal plane
-		ForwardVector.Normalize(); // Normalize the vector to maintain direction
-		ForwardVector*=AirSpeedMultiplier;
-		FVector DownForce=FVector(0,0,IsParachuting?-0.3f:-1.0f);
-		FVector Force = (ForwardVector +DownForce) * 3000000.0f; // Adjust the force magnitude as needed
-		GetMesh()->AddForce(Force);
-		//Add Torque on Z axis
-		FVector Torque = FVector(0.0f, 0.0f, 100.0f*Delta*AirTurnMultipler); // Adjust the torque magnitude as needed
-		GetMesh()->AddTorqueInRadians(Torque, NAME_None, true);
-		GEngine->AddOnScreenDebugMessage(89, 0.1f, FColor::Red, FString::Printf(TEXT("AirSpeedMultiplier: %f"), AirSpeedMultiplier));
-		GEngine->AddOnScreenDebugMessage(98, 0.1f, FColor::Red, FString::Printf(TEXT("AirTurnMultipler: %f"), AirTurnMultipler));
-		CheckForGround();
-	}
-	//--------------------------
-	CalculateAimLocation();
-	
-}
-
-void AUrbanCarnagePawn::Server_SetAirSpeedMultiplier_Implementation(float _AirSpeedMultiplier)
-{
-	AirSpeedMultiplier=_AirSpeedMultiplier;
-}
-void AUrbanCarnagePawn::Server_SetAirTurnMultiplier_Implementation(float _AirTurnMultiplier)
-{
-	AirTurnMultipler=_AirTurnMultiplier;
-}
-
-void AUrbanCarnagePawn::BeginPlay()
-{
-	Super::BeginPlay();
-	
-	if (IsLocallyControlled())
-	{
-		//get controller and call setup input
-		AUrbanCarnagePlayerController* PlayerController = Cast<AUrbanCarnagePlayerController>(GetController());
-		if (PlayerController)
-		{
-			PlayerController->setupContext();
-		}
-	}
-	if (HasAuthority()&&!IsLocallyControlled())
-	{
-		/*
-		 //spawn a primary weapon class in primaryweaponslot
-		PrimaryWeapon_Ref = GetWorld()->SpawnActor<AWeaponBase>(PrimaryWeaponClass, PrimaryWeaponSlot->GetComponentLocation(), PrimaryWeaponSlot->GetComponentRotation());
-		//attach primaryweapon_ref to the primaryweaponslot
-		PrimaryWeapon_Ref->AttachToComponent(PrimaryWeaponSlot, FAttachmentTransformRules::SnapToTargetNotIncludingScale);
-		PrimaryWeapon_Ref->SetOwner(this);
-		//spawn a secondary weapon class in secondaryweaponslot1
-		SecondaryWeapon_Ref1 = GetWorld()->SpawnActor<AWeaponBase>(SecondaryWeaponClass, SecondaryWeaponSlot1->GetComponentLocation(), SecondaryWeaponSlot1->GetComponentRotation());
-		//attach secondaryweapon_ref1 to the secondaryweaponslot1
-		SecondaryWeapon_Ref1->AttachToComponent(SecondaryWeaponSlot1, FAttachmentTransformRules::SnapToTargetNotIncludingScale);
-		SecondaryWeapon_Ref1->SetOwner(this);
-		//spawn a secondary weapon class in secondaryweaponslot2
-		SecondaryWeapon_Ref2 = GetWorld()->SpawnActor<AWeaponBase>(SecondaryWeaponClass, SecondaryWeaponSlot2->GetComponentLocation(), SecondaryWeaponSlot2->GetComponentRotation());
-		//attach secondaryweapon_ref2 to the secondaryweaponslot2
-		SecondaryWeapon_Ref2->AttachToComponent(SecondaryWeaponSlot2, FAttachmentTransformRules::SnapToTargetNotIncludingScale);
-		SecondaryWeapon_Ref2->SetOwner(this);
-		*/
-	} 
-	//add abilities from InitialAbilities
-	if (AbilitySystemComponent)
-	{
-		for (TSubclassOf<UGameplayAbility>& StartupAbility : InitialAbilities)
-		{
-			AbilitySystemComponent->GiveAbility(FGameplayAbilitySpec(StartupAbility.GetDefaultObject(), 1, 0));
-		}
-	}
-	
-}
-
-AWeaponBase* AUrbanCarnagePawn::EquipWeapon(TSubclassOf<AWeaponBase> WeaponClass, bool PrimaryWeapon)
-{
-	if (PrimaryWeapon)
-	{
-		if (PrimaryWeapon_Ref)return nullptr;
-		
-		PrimaryWeapon_Ref = GetWorld()->SpawnActor<AWeaponBase>(WeaponClass, PrimaryWeaponSlot->GetComponentLocation(), PrimaryWeaponSlot->GetComponentRotation());
-		//attach primaryweapon_ref to the primaryweaponslot
-		PrimaryWeapon_Ref->AttachToComponent(PrimaryWeaponSlot, FAttachmentTransformRules::SnapToTargetNotIncludingScale);
-		PrimaryWeapon_Ref->SetOwner(this);
-		return PrimaryWeapon_Ref;
-	}
-	else
-	{
-	//check if we have any secondary weapon and attach to the available slot else return false
-		if (!SecondaryWeapon_Ref2)
-		{
-			SecondaryWeapon_Ref2 = GetWorld()->SpawnActor<AWeaponBase>(WeaponClass, SecondaryWeaponSlot2->GetComponentLocation(), SecondaryWeaponSlot2->GetComponentRotation());
-			//attach secondaryweapon_ref2 to the secondaryweaponslot2
-			SecondaryWeapon_Ref2->AttachToComponent(SecondaryWeaponSlot2, FAttachmentTransformRules::SnapToTargetNotIncludingScale);
-			SecondaryWeapon_Ref2->SetOwner(this);
-			return SecondaryWeapon_Ref2;
-		}
-		else if (!SecondaryWeapon_Ref1)
-		{
-			SecondaryWeapon_Ref1 = GetWorld()->SpawnActor<AWeaponBase>(WeaponClass, SecondaryWeaponSlot1->GetComponentLocation(), SecondaryWeaponSlot1->GetComponentRotation());
-			//attach secondaryweapon_ref1 to the secondaryweaponslot1
-			SecondaryWeapon_Ref1->AttachToComponent(SecondaryWeaponSlot1, FAttachmentTransformRules::SnapToTargetNotIncludingScale);
-			SecondaryWeapon_Ref1->SetOwner(this);
-			return SecondaryWeapon_Ref1;
-		}
-		return nullptr;
-	}
-	
-}
-
-void AUrbanCarnagePawn::Steering(const FInputActionValue& Value)
-{
-	// get the input magnitude for steering
-	float SteeringValue = Value.Get<float>();
-
-	// add the input
-	ChaosVehicleMovement->SetSteeringInput(SteeringValue);
-	Server_SetAirTurnMultiplier(SteeringValue);
-}
-
-void AUrbanCarnagePawn::Throttle(const FInputActionValue& Value)
-{
-	// get the input magnitude for the throttle
-	float ThrottleValue = Value.Get<float>();
-
-	// add the input
-	ChaosVehicleMovement->SetThrottleInput(ThrottleValue);
-	float AirMulti=1;
-	if (ThrottleValue>0)
-	{
-		AirMulti=1.5f;
-	}
-	else if (ThrottleValue==0)
-	{
-		AirMulti=1;
-	}
-	
-	Server_SetAirSpeedMultiplier(AirMulti);
-}
-
-void AUrbanCarnagePawn::Brake(const FInputActionValue& Value)
-{
-	// get the input magnitude for the brakes
-	float BreakValue = Value.Get<float>();
-
-	// add the input
-	ChaosVehicleMovement->SetBrakeInput(BreakValue);
-	Server_SetAirSpeedMultiplier(0.5f);
-}
-
-void AUrbanCarnagePawn::StartBrake(const FInputActionValue& Value)
-{
-	float VehicleSpeed = ChaosVehicleMovement->GetForwardSpeed();
-	
-	
-	if ( VehicleSpeed > 0.0f)
-	{
-		BrakeLights(true);
-	}
-	if ( VehicleSpeed <= 0.0f)
-	{
-		BrakeLights(false);
-	}
-	
-	// call the Blueprint hook for the break lights
-
-}
-
-void AUrbanCarnagePawn::StopBrake(const FInputActionValue& Value)
-{
-	// call the Blueprint hook for the break lights
-	BrakeLights(false);
-
-	// reset brake input to zero
-	ChaosVehicleMovement->SetBrakeInput(0.0f);
-}
-
-void AUrbanCarnagePawn::StartHandbrake(const FInputActionValue& Value)
-{
-	// add the input
-	ChaosVehicleMovement->SetHandbrakeInput(true);
-
-	// call the Blueprint hook for the break lights
-	//BrakeLights(true);
-	Server_SetParachuting(true);
-}
-
-void AUrbanCarnagePawn::StopHandbrake(const FInputActionValue& Value)
-{
-	// add the input
-	ChaosVehicleMovement->SetHandbrakeInput(false);
-
-	// call the Blueprint hook for the break lights
-	//BrakeLights(false);
-}
-
-void AUrbanCarnagePawn::LookAround(const FInputActionValue& Value)
-{
-	// get value for looking around as 2D vector
-	
-	FVector2D LookValue = Value.Get<FVector2D>();
-
-	// add the input
-	AddControllerPitchInput(-LookValue.Y);
-	AddControllerYawInput(LookValue.X);
-
-}
-
-
-void AUrbanCarnagePawn::ResetVehicle(const FInputActionValue& Value)
-{
-	// reset to a location slightly above our current one
-	FVector ResetLocation = GetActorLocation() + FVector(0.0f, 0.0f, 50.0f);
-
-	// reset to our yaw. Ignore pitch and roll
-	FRotator ResetRotation = GetActorRotation();
-	ResetRotation.Pitch = 0.0f;
-	ResetRotation.Roll = 0.0f;
-	
-	// teleport the actor to the reset spot and reset physics
-	SetActorTransform(FTransform(ResetRotation, ResetLocation, FVector::OneVector), false, nullptr, ETeleportType::TeleportPhysics);
-
-	GetMesh()->SetPhysicsAngularVelocityInDegrees(FVector::ZeroVector);
-	GetMesh()->SetPhysicsLinearVelocity(FVector::ZeroVector);
-
-	UE_LOG(LogTemplateVehicle, Error, TEXT("Reset Vehicle"));
-}
-
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "UrbanCarnagePawn.h"
+
+#include "AbilitySystemBlueprintLibrary.h"
+#include "AbilitySystemComponent.h"
+#include "UrbanCarnageWheelFront.h"
+#include "UrbanCarnageWheelRear.h"
+#include "Components/SkeletalMeshComponent.h"
+#include "GameFramework/SpringArmComponent.h"
+#include "Camera/CameraComponent.h"
+#include "EnhancedInputComponent.h"
+#include "EnhancedInputSubsystems.h"
+#include "InputActionValue.h"
+#include "ChaosWheeledVehicleMovementComponent.h"
+#include "UrbanCarnagePlayerController.h"
+#include "VehicleTickSubsystem.h"
+#include "GroundQuerySubsystem.h"
+#include "LagCompensationSubsystem.h"
+#include "FireSchedulerSubsystem.h"
+#include "CosmeticEventSubsystem.h"
+#include "VehicleWeaponsComponent.h"
+#include "AirControlSimCallback.h"
+#include "UrbanCarnageReplicationGraph.h"
+#include "Engine/NetDriver.h"
+#include "Components/ArrowComponent.h"
+#include "Net/UnrealNetwork.h"
+#include "Net/Core/PushModel/PushModel.h"
+#include "Particles/ParticleSystemComponent.h"
+
+#define LOCTEXT_NAMESPACE "VehiclePawn"
+
+DEFINE_LOG_CATEGORY(LogTemplateVehicle);
+
+AUrbanCarnagePawn::AUrbanCarnagePawn()
+{
+
+
+	// construct the back camera boom
+	BackSpringArm = CreateDefaultSubobject<USpringArmComponent>(TEXT("Back Spring Arm"));
+	BackSpringArm->SetupAttachment(GetMesh());
+	BackSpringArm->TargetArmLength = 650.0f;
+	BackSpringArm->SocketOffset.Z = 150.0f;
+	BackSpringArm->bDoCollisionTest = false;
+	BackSpringArm->bInheritPitch = false;
+	BackSpringArm->bInheritRoll = false;
+	BackSpringArm->bEnableCameraRotationLag = true;
+	BackSpringArm->CameraRotationLagSpeed = 2.0f;
+	BackSpringArm->CameraLagMaxDistance = 50.0f;
+
+	BackCamera = CreateDefaultSubobject<UCameraComponent>(TEXT("Back Camera"));
+	BackCamera->SetupAttachment(BackSpringArm);
+
+	AbilitySystemComponent=CreateDefaultSubobject<UAbilitySystemComponent>(TEXT("AbilitySystemComponent"));
+	
+	// Configure the car mesh
+	GetMesh()->SetSimulatePhysics(true);
+	GetMesh()->SetCollisionProfileName(FName("Vehicle"));
+
+	// get the Chaos Wheeled movement component
+	ChaosVehicleMovement = CastChecked<UChaosWheeledVehicleMovementComponent>(GetVehicleMovement());
+
+	PrimaryWeaponSlot = CreateDefaultSubobject<USceneComponent>(TEXT("PrimaryWeaponSlot"));
+	PrimaryWeaponSlot->SetupAttachment(GetMesh());
+	SecondaryWeaponSlot1 = CreateDefaultSubobject<USceneComponent>(TEXT("SecondaryWeaponSlot1"));
+	SecondaryWeaponSlot1->SetupAttachment(GetMesh());
+	SecondaryWeaponSlot2 = CreateDefaultSubobject<USceneComponent>(TEXT("SecondaryWeaponSlot2"));
+	SecondaryWeaponSlot2->SetupAttachment(GetMesh());
+	WeaponsComponent = CreateDefaultSubobject<UVehicleWeaponsComponent>(TEXT("WeaponsComponent"));
+	
+	
+}
+
+void AUrbanCarnagePawn::GetLifetimeReplicatedProps(TArray<class FLifetimeProperty>& OutLifetimeProps) const
+{
+	Super::GetLifetimeReplicatedProps(OutLifetimeProps);
+	// push model, every write below has to call MARK_PROPERTY_DIRTY_FROM_NAME
+	FDoRepLifetimeParams Params;
+	Params.bIsPushBased = true;
+	DOREPLIFETIME_WITH_PARAMS_FAST(AUrbanCarnagePawn,BulletClass,Params);
+	DOREPLIFETIME_WITH_PARAMS_FAST(AUrbanCarnagePawn,bIsInAir,Params);
+	DOREPLIFETIME_WITH_PARAMS_FAST(AUrbanCarnagePawn,AirSpeedMultiplier,Params);
+	DOREPLIFETIME_WITH_PARAMS_FAST(AUrbanCarnagePawn,AirTurnMultipler,Params);
+	DOREPLIFETIME_WITH_PARAMS_FAST(AUrbanCarnagePawn,IsParachuting,Params);
+	// the weapons component replicates the weapons itself, the references would point at actors clients do not have
+	FDoRepLifetimeParams WeaponRefParams;
+	WeaponRefParams.bIsPushBased = true;
+	WeaponRefParams.Condition = COND_Custom;
+	DOREPLIFETIME_WITH_PARAMS_FAST(AUrbanCarnagePawn,PrimaryWeapon_Ref,WeaponRefParams);
+	DOREPLIFETIME_WITH_PARAMS_FAST(AUrbanCarnagePawn,SecondaryWeapon_Ref1,WeaponRefParams);
+	DOREPLIFETIME_WITH_PARAMS_FAST(AUrbanCarnagePawn,SecondaryWeapon_Ref2,WeaponRefParams);
+	// the owning client computes its own AimPoint every frame
+	FDoRepLifetimeParams SkipOwnerParams;
+	SkipOwnerParams.bIsPushBased = true;
+	SkipOwnerParams.Condition = COND_SkipOwner;
+	DOREPLIFETIME_WITH_PARAMS_FAST(AUrbanCarnagePawn,AimPoint,SkipOwnerParams);
+	// simulated proxies get the snapshot stream, ReplicatedMovement only corrects the owner
+	// (including the kinematic deploy glide, not only physics movement)
+	FDoRepLifetimeParams SimulatedOnlyParams;
+	SimulatedOnlyParams.bIsPushBased = true;
+	SimulatedOnlyParams.Condition = COND_SimulatedOnly;
+	DOREPLIFETIME_WITH_PARAMS_FAST(AUrbanCarnagePawn,VehicleSnapshot,SimulatedOnlyParams);
+	RESET_REPLIFETIME_CONDITION_PRIVATE_PROPERTY(AActor, ReplicatedMovement, COND_AutonomousOnly);
+	
+}
+
+
+void AUrbanCarnagePawn::SetupPlayerInputComponent(class UInputComponent* PlayerInputComponent)
+{
+	Super::SetupPlayerInputComponent(PlayerInputComponent);
+
+	if (UEnhancedInputComponent* EnhancedInputComponent = Cast<UEnhancedInputComponent>(PlayerInputComponent))
+	{
+		// steering
+		EnhancedInputComponent->BindAction(SteeringAction, ETriggerEvent::Triggered, this, &AUrbanCarnagePawn::Steering);
+		EnhancedInputComponent->BindAction(SteeringAction, ETriggerEvent::Completed, this, &AUrbanCarnagePawn::Steering);
+
+		// throttle 
+		EnhancedInputComponent->BindAction(ThrottleAction, ETriggerEvent::Triggered, this, &AUrbanCarnagePawn::Throttle);
+		EnhancedInputComponent->BindAction(ThrottleAction, ETriggerEvent::Completed, this, &AUrbanCarnagePawn::Throttle);
+
+		// break 
+		EnhancedInputComponent->BindAction(BrakeAction, ETriggerEvent::Triggered, this, &AUrbanCarnagePawn::Brake);
+		EnhancedInputComponent->BindAction(BrakeAction, ETriggerEvent::Started, this, &AUrbanCarnagePawn::StartBrake);
+		EnhancedInputComponent->BindAction(BrakeAction, ETriggerEvent::Completed, this, &AUrbanCarnagePawn::StopBrake);
+
+		// handbrake 
+		EnhancedInputComponent->BindAction(HandbrakeAction, ETriggerEvent::Started, this, &AUrbanCarnagePawn::StartHandbrake);
+		EnhancedInputComponent->BindAction(HandbrakeAction, ETriggerEvent::Completed, this, &AUrbanCarnagePawn::StopHandbrake);
+
+		// look around 
+		EnhancedInputComponent->BindAction(LookAroundAction, ETriggerEvent::Triggered, this, &AUrbanCarnagePawn::LookAround);
+		
+		// reset the vehicle 
+		EnhancedInputComponent->BindAction(ResetVehicleAction, ETriggerEvent::Triggered, this, &AUrbanCarnagePawn::ResetVehicle);
+		// Fire
+		EnhancedInputComponent->BindAction(FireAction, ETriggerEvent::Triggered, this, &AUrbanCarnagePawn::Fire);
+		EnhancedInputComponent->BindAction(FireAction, ETriggerEvent::Completed, this, &AUrbanCarnagePawn::StopFire);
+	}
+	else
+	{
+		UE_LOG(LogTemplateVehicle, Error, TEXT("'%s' Failed to find an Enhanced Input component! This template is built to use the Enhanced Input system. If you intend to use the legacy system, then you will need to update this C++ file."), *GetNameSafe(this));
+	}
+}
+
+
+void AUrbanCarnagePawn::Fire(const FInputActionValue& Value)
+{
+	// the server fires right away, clients predict their shots and send them once per frame
+	if (!IsLocallyControlled()) return;
+	if (PrimaryWeapon_Ref)
+	{
+		PrimaryWeapon_Ref->Shoot();
+	}
+	if (SecondaryWeapon_Ref1)
+	{
+		SecondaryWeapon_Ref1->Shoot();
+	}
+	if (SecondaryWeapon_Ref2)
+	{
+		SecondaryWeapon_Ref2->Shoot();
+	}
+}
+
+void AUrbanCarnagePawn::StopFire(const FInputActionValue& Value)
+{
+	if (!IsLocallyControlled()) return;
+	ReleaseWeaponTriggers();
+	if (!HasAuthority())
+	{
+		Server_StopFire();
+	}
+}
+
+void AUrbanCarnagePawn::Server_StopFire_Implementation()
+{
+	ReleaseWeaponTriggers();
+}
+
+void AUrbanCarnagePawn::ReleaseWeaponTriggers()
+{
+	for (int32 Slot = 0; Slot < 3; ++Slot)
+	{
+		if (AWeaponBase* Weapon = GetWeaponInSlot(Slot))
+		{
+			Weapon->StopShooting();
+		}
+	}
+}
+
+int32 AUrbanCarnagePawn::GetWeaponSlot(const AWeaponBase* Weapon) const
+{
+	if (!Weapon) return INDEX_NONE;
+	if (Weapon == PrimaryWeapon_Ref) return 0;
+	if (Weapon == SecondaryWeapon_Ref1) return 1;
+	if (Weapon == SecondaryWeapon_Ref2) return 2;
+	return INDEX_NONE;
+}
+
+AWeaponBase* AUrbanCarnagePawn::GetWeaponInSlot(int32 Slot) const
+{
+	switch (Slot)
+	{
+	case 0: return PrimaryWeapon_Ref;
+	case 1: return SecondaryWeapon_Ref1;
+	case 2: return SecondaryWeapon_Ref2;
+	default: return nullptr;
+	}
+}
+
+USceneComponent* AUrbanCarnagePawn::GetWeaponSlotComponent(int32 Slot) const
+{
+	switch (Slot)
+	{
+	case 0: return PrimaryWeaponSlot;
+	case 1: return SecondaryWeaponSlot1;
+	case 2: return SecondaryWeaponSlot2;
+	default: return nullptr;
+	}
+}
+
+void AUrbanCarnagePawn::SetWeaponInSlot(int32 Slot, AWeaponBase* Weapon)
+{
+	switch (Slot)
+	{
+	case 0:
+		PrimaryWeapon_Ref = Weapon;
+		MARK_PROPERTY_DIRTY_FROM_NAME(AUrbanCarnagePawn, PrimaryWeapon_Ref, this);
+		break;
+	case 1:
+		SecondaryWeapon_Ref1 = Weapon;
+		MARK_PROPERTY_DIRTY_FROM_NAME(AUrbanCarnagePawn, SecondaryWeapon_Ref1, this);
+		break;
+	case 2:
+		SecondaryWeapon_Ref2 = Weapon;
+		MARK_PROPERTY_DIRTY_FROM_NAME(AUrbanCarnagePawn, SecondaryWeapon_Ref2, this);
+		break;
+	default:
+		break;
+	}
+}
+
+void AUrbanCarnagePawn::QueueShotEvent(const FShotFiredEvent& Shot)
+{
+	PendingShotEvents.Add(Shot);
+}
+
+void AUrbanCarnagePawn::FlushShotEvents()
+{
+	if (!HasAuthority())
+	{
+		ExpireUnackedShots();
+		if (PendingPredictedShots.Num() > 0)
+		{
+			Server_FireShots(PendingPredictedShots);
+			PendingPredictedShots.Reset();
+		}
+		return;
+	}
+	if (PendingShotEvents.Num() > 0)
+	{
+		Multicast_ShotsFired(PendingShotEvents);
+		PendingShotEvents.Reset();
+	}
+	if (bShotAckPending)
+	{
+		Client_AckShots(AckShotSequence, AcceptedShotMask);
+		bShotAckPending = false;
+	}
+}
+
+void AUrbanCarnagePawn::Multicast_ShotsFired_Implementation(const TArray<FShotFiredEvent>& Shots)
+{
+	// the server already simulates the authoritative projectiles, the owner played its shots when it predicted them
+	if (HasAuthority() || IsLocallyControlled()) return;
+	// a vehicle that fires is worth its weapons again, for at least WeaponCopiesSuspendDelay
+	LastShotsFiredTime = GetWorld()->GetTimeSeconds();
+	if (bUseWeaponComponent && WeaponsComponent)
+	{
+		WeaponsComponent->SetLocalCopiesSuspended(false);
+	}
+	for (const FShotFiredEvent& Shot : Shots)
+	{
+		if (AWeaponBase* Weapon = GetWeaponInSlot(Shot.WeaponSlot))
+		{
+			Weapon->SimulateShotFired(Shot);
+		}
+	}
+}
+
+void AUrbanCarnagePawn::QueuePredictedShot(const FShotFiredEvent& Shot)
+{
+	FPredictedShot& Predicted = PendingPredictedShots.AddDefaulted_GetRef();
+	Predicted.Shot = Shot;
+	Predicted.Sequence = NextShotSequence++;
+
+	FUnackedShot& Unacked = UnackedShots.AddDefaulted_GetRef();
+	Unacked.Sequence = Predicted.Sequence;
+	Unacked.WeaponSlot = Shot.WeaponSlot;
+	Unacked.FireTime = GetWorld()->GetTimeSeconds();
+}
+
+void AUrbanCarnagePawn::ExpireUnackedShots()
+{
+	const double Now = GetWorld()->GetTimeSeconds();
+	for (int32 Index = UnackedShots.Num() - 1; Index >= 0; --Index)
+	{
+		if (Now - UnackedShots[Index].FireTime > UnackedShotTimeout)
+		{
+			RejectPredictedShot(UnackedShots[Index]);
+			UnackedShots.RemoveAtSwap(Index, 1, EAllowShrinking::No);
+		}
+	}
+}
+
+void AUrbanCarnagePawn::RejectPredictedShot(const FUnackedShot& Unacked)
+{
+	if (AWeaponBase* Weapon = GetWeaponInSlot(Unacked.WeaponSlot))
+	{
+		Weapon->PredictedShotRejectedBP();
+	}
+}
+
+void AUrbanCarnagePawn::Server_FireShots_Implementation(const TArray<FPredictedShot>& Shots)
+{
+	UFireSchedulerSubsystem* Scheduler = GetWorld()->GetSubsystem<UFireSchedulerSubsystem>();
+	for (const FPredictedShot& Predicted : Shots)
+	{
+		FShotFiredEvent Shot = Predicted.Shot;
+		Shot.Direction = Shot.Direction.GetSafeNormal();
+		AWeaponBase* Weapon = GetWeaponInSlot(Shot.WeaponSlot);
+		// the cooldown is checked last so a shot from the wrong place does not use it up
+		const bool bAccepted = Weapon && Scheduler && !Shot.Direction.IsZero()
+			&& Weapon->ValidatePredictedShot(Shot)
+			&& Scheduler->ConsumePredictedShot(Weapon)
+			&& Weapon->FireAuthoritativeShot(Shot, 0.0f);
+		RecordShotVerdict(Predicted.Sequence, bAccepted);
+	}
+	// the shot events and the ack go out with the vehicle tick, batched with the rest of the frame
+}
+
+void AUrbanCarnagePawn::RecordShotVerdict(uint16 Sequence, bool bAccepted)
+{
+	if (!bHasAckedShots)
+	{
+		bHasAckedShots = true;
+		AckShotSequence = Sequence;
+		AcceptedShotMask = 0;
+	}
+	// sequences skipped here belong to batches that never arrived, their bits stay clear
+	const int16 Ahead = (int16)(uint16)(Sequence - AckShotSequence);
+	if (Ahead > 0)
+	{
+		AcceptedShotMask = Ahead < 32 ? AcceptedShotMask << Ahead : 0;
+		AckShotSequence = Sequence;
+	}
+	// arrived too late to fit in the mask, the client has already given up on it
+	const int32 Behind = (int32)(uint16)(AckShotSequence - Sequence);
+	if (Behind >= 32) return;
+	if (bAccepted)
+	{
+		AcceptedShotMask |= 1u << Behind;
+	}
+	bShotAckPending = true;
+}
+
+void AUrbanCarnagePawn::Client_AckShots_Implementation(uint16 NewestSequence, uint32 AcceptedMask)
+{
+	for (int32 Index = UnackedShots.Num() - 1; Index >= 0; --Index)
+	{
+		const FUnackedShot& Unacked = UnackedShots[Index];
+		const int32 Behind = (int32)(uint16)(NewestSequence - Unacked.Sequence);
+		if (Behind >= 32) continue;
+		if ((AcceptedMask & (1u << Behind)) == 0)
+		{
+			RejectPredictedShot(Unacked);
+		}
+		UnackedShots.RemoveAtSwap(Index, 1, EAllowShrinking::No);
+	}
+	ExpireUnackedShots();
+}
+
+void AUrbanCarnagePawn::SetDeployMode(bool bDeploy)
+{
+	bIsInAir=bDeploy;
+	MARK_PROPERTY_DIRTY_FROM_NAME(AUrbanCarnagePawn, bIsInAir, this);
+	UCosmeticEventSubsystem::Post(this, bIsInAir ? ECosmeticEventType::DeployStart : ECosmeticEventType::DeployStop);
+	if (!bIsInAir) UCosmeticEventSubsystem::Post(this, ECosmeticEventType::ParachuteStop);
+	GetMesh()->SetEnableGravity(!bDeploy);
+	GetMesh()->SetLinearDamping(bIsInAir?1.0f:0.1f);
+	GetMesh()->SetAngularDamping(bIsInAir?1.0f:0.1f);
+	if (bUseKinematicDeploy) SetKinematicGlide(bDeploy);
+	
+}
+
+void AUrbanCarnagePawn::LandOnGround()
+{
+	if (!bIsInAir) return;
+	bIsInAir=false;
+	MARK_PROPERTY_DIRTY_FROM_NAME(AUrbanCarnagePawn, bIsInAir, this);
+	GetMesh()->SetEnableGravity(true);
+	GetMesh()->SetLinearDamping(0.1f);
+	GetMesh()->SetAngularDamping(0.1f);
+	SetKinematicGlide(false);
+	UCosmeticEventSubsystem::Post(this, ECosmeticEventType::DeployStop);
+	UCosmeticEventSubsystem::Post(this, ECosmeticEventType::ParachuteStop);
+}
+
+void AUrbanCarnagePawn::OnRep_IsInAir()
+{
+	// the owner runs the same glide between movement updates, simulated proxies follow the snapshots
+	if (bUseKinematicDeploy || !bIsInAir) SetKinematicGlide(bIsInAir);
+}
+
+void AUrbanCarnagePawn::SetKinematicGlide(bool bGlide)
+{
+	if (bGlide == bKinematicGlide) return;
+	bKinematicGlide = bGlide;
+	USkeletalMeshComponent* VehicleMesh = GetMesh();
+	// a Kinematic simulation LOD keeps physics off on its own
+	const bool bOwnsPhysics = SimulationLOD != EVehicleSimLOD::Kinematic;
+	if (bGlide)
+	{
+		GlideVelocity = GetVelocity();
+		GlideYawRate = FMath::DegreesToRadians(VehicleMesh->GetPhysicsAngularVelocityInDegrees().Z);
+		GlideMass = FMath::Max(VehicleMesh->GetMass(), 1.0f);
+		VehicleMesh->ComponentVelocity = GlideVelocity;
+		if (bOwnsPhysics)
+		{
+			ChaosVehicleMovement->SetComponentTickEnabled(false);
+			VehicleMesh->SetSimulatePhysics(false);
+		}
+		return;
+	}
+	if (bOwnsPhysics)
+	{
+		// the landing keeps the momentum of the glide, or of the snapshots on simulated proxies
+		const FVector Velocity = GetVelocity();
+		ChaosVehicleMovement->SetComponentTickEnabled(true);
+		VehicleMesh->SetSimulatePhysics(true);
+		VehicleMesh->SetPhysicsLinearVelocity(Velocity);
+		VehicleMesh->SetPhysicsAngularVelocityInRadians(FVector(0.0f, 0.0f, GlideYawRate));
+	}
+}
+
+void AUrbanCarnagePawn::UpdateKinematicGlide(float Delta)
+{
+	if (!bKinematicGlide || Delta <= 0.0f) return;
+	FAirControlVehicleState State;
+	State.SpeedMultiplier = AirSpeedMultiplier;
+	State.TurnMultiplier = AirTurnMultipler;
+	State.bParachuting = IsParachuting;
+
+	// the physics thread forces and the body damping, integrated here instead of by Chaos
+	const USkeletalMeshComponent* VehicleMesh = GetMesh();
+	const FQuat Rotation = GetActorQuat();
+	GlideVelocity += FAirControlSimCallback::CalculateForce(Rotation, State) / GlideMass * Delta;
+	GlideVelocity *= FMath::Max(0.0f, 1.0f - VehicleMesh->GetLinearDamping() * Delta);
+	GlideYawRate += FAirControlSimCallback::CalculateYawAcceleration(State) * Delta;
+	GlideYawRate *= FMath::Max(0.0f, 1.0f - VehicleMesh->GetAngularDamping() * Delta);
+
+	// replicated as the movement velocity and read by the ground query
+	GetMesh()->ComponentVelocity = GlideVelocity;
+	const FQuat DeltaRotation(FVector::UpVector, GlideYawRate * Delta);
+	SetActorLocationAndRotation(GetActorLocation() + GlideVelocity * Delta, DeltaRotation * Rotation, false, nullptr, ETeleportType::TeleportPhysics);
+}
+
+float AUrbanCarnagePawn::GetHeightAboveGround() const
+{
+	const UGroundQuerySubsystem* GroundQuery = GetWorld()->GetSubsystem<UGroundQuerySubsystem>();
+	return GroundQuery ? GroundQuery->GetHeightAboveGround(this) : -1.0f;
+}
+
+void AUrbanCarnagePawn::CalculateAimLocation()
+{
+	if (!IsLocallyControlled()) return;
+	UWorld* World = GetWorld();
+	const FVector StartLocation = BackCamera->GetComponentLocation();
+	const FVector Direction = BackCamera->GetForwardVector();
+
+	// pick up the async trace issued last frame
+	if (AimTraceHandle.IsValid())
+	{
+		FTraceDatum TraceData;
+		if (World->QueryTraceData(AimTraceHandle, TraceData))
+		{
+			const FHitResult* Hit = TraceData.OutHits.FindByPredicate([](const FHitResult& Result) { return Result.bBlockingHit; });
+			AimHitDistance = Hit ? (float)Hit->Distance : AimMaxRange;
+			AimTraceHandle = FTraceHandle();
+		}
+		else if (!World->IsTraceHandleValid(AimTraceHandle, false))
+		{
+			AimTraceHandle = FTraceHandle();
+		}
+	}
+	if (LastAimTraceTime < 0.0)
+	{
+		AimHitDistance = AimMaxRange;
+	}
+
+	// only trace again when the camera moved or turned enough, or the last hit got old
+	const double Now = World->GetTimeSeconds();
+	const bool bCameraMoved = FVector::DistSquared(StartLocation, LastAimTraceStart) > FMath::Square(AimTraceReuseDistance)
+		|| FVector::DotProduct(Direction, LastAimTraceDirection) < FMath::Cos(FMath::DegreesToRadians(AimTraceReuseAngle));
+	if (!AimTraceHandle.IsValid() && (LastAimTraceTime < 0.0 || bCameraMoved || Now - LastAimTraceTime > AimTraceMaxAge))
+	{
+		FCollisionQueryParams CollisionParams(SCENE_QUERY_STAT(AimTrace), false, this);
+		AimTraceHandle = World->AsyncLineTraceByChannel(EAsyncTraceType::Single, StartLocation, StartLocation + Direction * AimMaxRange, AimTraceChannel, CollisionParams);
+		LastAimTraceStart = StartLocation;
+		LastAimTraceDirection = Direction;
+		LastAimTraceTime = Now;
+	}
+
+	// the hit distance is carried along the current camera ray until the next result comes in
+	AimPoint = StartLocation + Direction * AimHitDistance;
+	MARK_PROPERTY_DIRTY_FROM_NAME(AUrbanCarnagePawn, AimPoint, this);
+
+	if (bUseQuantizedAimStream)
+	{
+		SendQuantizedAim();
+	}
+	else
+	{
+		Server_SetAimLocation(AimPoint);
+	}
+	// the server aims its copy from the RPCs, the owning client turns its own turrets right away
+	if (!HasAuthority())
+	{
+		AimWeapons(AimPoint);
+	}
+}
+
+void AUrbanCarnagePawn::SendQuantizedAim()
+{
+	// the listen server host aims its weapons directly from AimPoint
+	if (HasAuthority()) return;
+
+	const double Now = GetWorld()->GetTimeSeconds();
+	// cap the send rate
+	if (AimMaxSendRate > 0.0f && LastAimSendTime >= 0.0 && Now - LastAimSendTime < 1.0 / AimMaxSendRate) return;
+
+	const FQuantizedAim NewAim = FQuantizedAim::Quantize(AimPoint - GetActorLocation(), AimMaxRange);
+	const float CosDelta = FVector::DotProduct(NewAim.GetDirection(), LastSentAim.GetDirection());
+	const float AngleDelta = FMath::RadiansToDegrees(FMath::Acos(FMath::Clamp(CosDelta, -1.0f, 1.0f)));
+	const bool bChanged = LastAimSendTime < 0.0 || AngleDelta >= AimSendAngleThreshold || NewAim.RangeBucket != LastSentAim.RangeBucket;
+	if (!bChanged && Now - LastAimSendTime < AimKeepAliveInterval) return;
+
+	LastSentAim = NewAim;
+	LastAimSendTime = Now;
+	Server_SetQuantizedAim(NewAim);
+}
+
+void AUrbanCarnagePawn::Server_SetQuantizedAim_Implementation(FQuantizedAim _Aim)
+{
+	AimTargetDirection = _Aim.GetDirection();
+	AimTargetRange = _Aim.GetRange(AimMaxRange);
+	if (!bHasAimTarget)
+	{
+		// snap on the first sample instead of sweeping from the origin
+		AimPoint = GetActorLocation() + AimTargetDirection * AimTargetRange;
+		MARK_PROPERTY_DIRTY_FROM_NAME(AUrbanCarnagePawn, AimPoint, this);
+		bHasAimTarget = true;
+	}
+}
+
+void AUrbanCarnagePawn::UpdateServerAim(float Delta)
+{
+	if (IsLocallyControlled())
+	{
+		AimWeapons(AimPoint);
+		return;
+	}
+	if (!bHasAimTarget) return;
+	// the sample is relative to the vehicle so the target follows the car between samples
+	const FVector TargetPoint = GetActorLocation() + AimTargetDirection * AimTargetRange;
+	const FVector NewAimPoint = FMath::VInterpTo(AimPoint, TargetPoint, Delta, AimSmoothingSpeed);
+	if (!NewAimPoint.Equals(AimPoint, 1.0f))
+	{
+		AimPoint = NewAimPoint;
+		MARK_PROPERTY_DIRTY_FROM_NAME(AUrbanCarnagePawn, AimPoint, this);
+	}
+	AimWeapons(AimPoint);
+}
+
+void AUrbanCarnagePawn::AimWeapons(const FVector& _AimPoint)
+{
+	if (PrimaryWeapon_Ref)
+		PrimaryWeapon_Ref->Aim(_AimPoint);
+	if (SecondaryWeapon_Ref1)
+		SecondaryWeapon_Ref1->Aim(_AimPoint);
+	if (SecondaryWeapon_Ref2)
+		SecondaryWeapon_Ref2->Aim(_AimPoint);
+}
+
+void AUrbanCarnagePawn::Death()
+{
+	if (isDead) return;
+	if (HasAuthority())
+	{
+		
+		UCosmeticEventSubsystem::Post(this, ECosmeticEventType::Destroyed);
+		//launch car upwards and add random touqe
+		GetMesh()->AddImpulse(FVector(0,0,6000));
+		GetMesh()->AddTorqueInRadians(FVector(FMath::RandRange(-500,500),FMath::RandRange(-500,500),FMath::RandRange(-500,500)),"None",true);
+		//Destroy();
+		isDead=true;
+		//unpossess
+		AController* _Controller = GetController();
+		if (_Controller)
+		{
+			_Controller->UnPossess();
+		}
+	}
+		
+	/*if (AbilitySystemComponent)
+	{
+	    FGameplayTag DeathAbilityTag = FGameplayTag::RequestGameplayTag(FName("Ability.Death"));
+	    bool HasAbility = AbilitySystemComponent->HasMatchingGameplayTag(DeathAbilityTag);
+	    GEngine->AddOnScreenDebugMessage(-1, 5.f, FColor::Green, FString::Printf(TEXT("Has Ability with tag 'Ability.Death': %d"), HasAbility));
+		//activate
+			    bool CanDo= AbilitySystemComponent->TryActivateAbilitiesByTag(FGameplayTagContainer(DeathAbilityTag));
+	    //print can do to screen
+	    if (GEngine)
+	    {
+	        GEngine->AddOnScreenDebugMessage(89, 2.0f, FColor::Red, FString::Printf(TEXT("Can do: %d"), CanDo));
+	    }
+	}*/
+}
+
+void AUrbanCarnagePawn::Destroyed()
+{
+	Super::Destroyed();
+	if (!HasAuthority())return;
+	//destroy all weapons
+	if (PrimaryWeapon_Ref)
+	{
+		PrimaryWeapon_Ref->Destroy();
+	}
+	if (SecondaryWeapon_Ref1)
+	{
+		SecondaryWeapon_Ref1->Destroy();
+	}
+	if (SecondaryWeapon_Ref2)
+	{
+		SecondaryWeapon_Ref2->Destroy();
+	}
+	
+}
+
+void AUrbanCarnagePawn::Server_SetAimLocation_Implementation(FVector _AimPoint)
+{
+	AimPoint=_AimPoint;
+	MARK_PROPERTY_DIRTY_FROM_NAME(AUrbanCarnagePawn, AimPoint, this);
+	AimWeapons(AimPoint);
+}
+
+void AUrbanCarnagePawn::SetParachuting(bool bParachuting)
+{
+	if (!bIsInAir) return;
+	IsParachuting=bParachuting;
+	MARK_PROPERTY_DIRTY_FROM_NAME(AUrbanCarnagePawn, IsParachuting, this);
+	if (IsParachuting)
+	{
+		UCosmeticEventSubsystem::Post(this, ECosmeticEventType::ParachuteOpen);
+	}
+}
+
+void AUrbanCarnagePawn::FlushVehicleInput()
+{
+	if (!IsLocallyControlled()) return;
+	// the air multipliers and the parachute are only read while in the air
+	if (!bIsInAir)
+	{
+		PendingInput.SetFlag(FPackedVehicleInput::Flag_Parachute, false);
+		LastInputSendTime = -1.0;
+		return;
+	}
+	if (HasAuthority())
+	{
+		ApplyVehicleInput(PendingInput);
+		return;
+	}
+
+	const double Now = GetWorld()->GetTimeSeconds();
+	const bool bChanged = LastInputSendTime < 0.0 || PendingInput != LastSentInput;
+	if (!bChanged && Now - LastInputSendTime < InputKeepAliveInterval) return;
+
+	LastSentInput = PendingInput;
+	LastInputSendTime = Now;
+	Server_SetVehicleInput(PendingInput);
+}
+
+void AUrbanCarnagePawn::Server_SetVehicleInput_Implementation(FPackedVehicleInput _Input)
+{
+	ApplyVehicleInput(_Input);
+}
+
+void AUrbanCarnagePawn::ApplyVehicleInput(const FPackedVehicleInput& _Input)
+{
+	if (!bIsInAir) return;
+	const float NewTurnMultiplier = _Input.GetSteering();
+	if (AirTurnMultipler != NewTurnMultiplier)
+	{
+		AirTurnMultipler = NewTurnMultiplier;
+		MARK_PROPERTY_DIRTY_FROM_NAME(AUrbanCarnagePawn, AirTurnMultipler, this);
+	}
+	float NewSpeedMultiplier = 1.0f;
+	if (_Input.Brake > 0)
+	{
+		NewSpeedMultiplier = 0.5f;
+	}
+	else if (_Input.Throttle > 0)
+	{
+		NewSpeedMultiplier = 1.5f;
+	}
+	if (AirSpeedMultiplier != NewSpeedMultiplier)
+	{
+		AirSpeedMultiplier = NewSpeedMultiplier;
+		MARK_PROPERTY_DIRTY_FROM_NAME(AUrbanCarnagePawn, AirSpeedMultiplier, this);
+	}
+	if (_Input.HasFlag(FPackedVehicleInput::Flag_Parachute) && !IsParachuting)
+	{
+		SetParachuting(true);
+	}
+}
+
+void AUrbanCarnagePawn::BeginPlay()
+{
+	Super::BeginPlay();
+
+	for (const FChaosWheelSetup& WheelSetup : ChaosVehicleMovement->WheelSetups)
+	{
+		FullLODWheelClasses.Add(WheelSetup.WheelClass);
+	}
+
+	// the vehicle tick subsystem updates all vehicles and their weapons in one pass
+	if (UVehicleTickSubsystem* VehicleTick = GetWorld()->GetSubsystem<UVehicleTickSubsystem>())
+	{
+		VehicleTick->RegisterVehicle(this);
+	}
+	// the server keeps a movement history to validate hits against
+	if (HasAuthority())
+	{
+		if (ULagCompensationSubsystem* LagCompensation = GetWorld()->GetSubsystem<ULagCompensationSubsystem>())
+		{
+			LagCompensation->RegisterVehicle(this);
+		}
+	}
+	
+	if (IsLocallyControlled())
+	{
+		//get controller and call setup input
+		AUrbanCarnagePlayerController* PlayerController = Cast<AUrbanCarnagePlayerController>(GetController());
+		if (PlayerController)
+		{
+			PlayerController->setupContext();
+		}
+	}
+	if (HasAuthority()&&!IsLocallyControlled())
+	{
+		/*
+		 //spawn a primary weapon class in primaryweaponslot
+		PrimaryWeapon_Ref = GetWorld()->SpawnActor<AWeaponBase>(PrimaryWeaponClass, PrimaryWeaponSlot->GetComponentLocation(), PrimaryWeaponSlot->GetComponentRotation());
+		//attach primaryweapon_ref to the primaryweaponslot
+		PrimaryWeapon_Ref->AttachToComponent(PrimaryWeaponSlot, FAttachmentTransformRules::SnapToTargetNotIncludingScale);
+		PrimaryWeapon_Ref->SetOwner(this);
+		//spawn a secondary weapon class in secondaryweaponslot1
+		SecondaryWeapon_Ref1 = GetWorld()->SpawnActor<AWeaponBase>(SecondaryWeaponClass, SecondaryWeaponSlot1->GetComponentLocation(), SecondaryWeaponSlot1->GetComponentRotation());
+		//attach secondaryweapon_ref1 to the secondaryweaponslot1
+		SecondaryWeapon_Ref1->AttachToComponent(SecondaryWeaponSlot1, FAttachmentTransformRules::SnapToTargetNotIncludingScale);
+		SecondaryWeapon_Ref1->SetOwner(this);
+		//spawn a secondary weapon class in secondaryweaponslot2
+		SecondaryWeapon_Ref2 = GetWorld()->SpawnActor<AWeaponBase>(SecondaryWeaponClass, SecondaryWeaponSlot2->GetComponentLocation(), SecondaryWeaponSlot2->GetComponentRotation());
+		//attach secondaryweapon_ref2 to the secondaryweaponslot2
+		SecondaryWeapon_Ref2->AttachToComponent(SecondaryWeaponSlot2, FAttachmentTransformRules::SnapToTargetNotIncludingScale);
+		SecondaryWeapon_Ref2->SetOwner(this);
+		*/
+	} 
+	//add abilities from InitialAbilities
+	if (AbilitySystemComponent)
+	{
+		for (TSubclassOf<UGameplayAbility>& StartupAbility : InitialAbilities)
+		{
+			AbilitySystemComponent->GiveAbility(FGameplayAbilitySpec(StartupAbility.GetDefaultObject(), 1, 0));
+		}
+	}
+	
+}
+
+void AUrbanCarnagePawn::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+	if (UVehicleTickSubsystem* VehicleTick = GetWorld()->GetSubsystem<UVehicleTickSubsystem>())
+	{
+		VehicleTick->UnregisterVehicle(this);
+	}
+	if (ULagCompensationSubsystem* LagCompensation = GetWorld()->GetSubsystem<ULagCompensationSubsystem>())
+	{
+		LagCompensation->UnregisterVehicle(this);
+	}
+	Super::EndPlay(EndPlayReason);
+}
+
+void AUrbanCarnagePawn::UpdateWeaponCopiesSuspension()
+{
+	if (SimulationLOD != EVehicleSimLOD::Kinematic || !bUseWeaponComponent || !WeaponsComponent || WeaponsComponent->AreLocalCopiesSuspended()) return;
+	// a vehicle too far or out of view to simulate for a while does not need its weapon actors either
+	const double Now = GetWorld()->GetTimeSeconds();
+	if (Now - FMath::Max(SimulationLODChangeTime, LastShotsFiredTime) >= WeaponCopiesSuspendDelay)
+	{
+		WeaponsComponent->SetLocalCopiesSuspended(true);
+	}
+}
+
+void AUrbanCarnagePawn::SetSimulationLOD(EVehicleSimLOD NewLOD)
+{
+	// our own vehicle is always simulated in full, the server never stops simulating
+	if (IsLocallyControlled())
+	{
+		NewLOD = EVehicleSimLOD::Full;
+	}
+	else if (HasAuthority() && NewLOD == EVehicleSimLOD::Kinematic)
+	{
+		NewLOD = EVehicleSimLOD::Reduced;
+	}
+	if (NewLOD == SimulationLOD) return;
+
+	const EVehicleSimLOD OldLOD = SimulationLOD;
+	SimulationLOD = NewLOD;
+	SimulationLODChangeTime = GetWorld()->GetTimeSeconds();
+
+	if (NewLOD == EVehicleSimLOD::Full)
+	{
+		SetWheelClasses(FullLODWheelClasses);
+	}
+	else if (OldLOD == EVehicleSimLOD::Full)
+	{
+		SetWheelClasses(ReducedLODWheelClasses);
+	}
+
+	// the weapon copies are only suspended once the vehicle stayed Kinematic, see UpdateWeaponCopiesSuspension
+	if (bUseWeaponComponent && WeaponsComponent && NewLOD != EVehicleSimLOD::Kinematic)
+	{
+		WeaponsComponent->SetLocalCopiesSuspended(false);
+	}
+
+	const float TickInterval = NewLOD == EVehicleSimLOD::Full ? 0.0f : ReducedLODTickInterval;
+	ChaosVehicleMovement->SetComponentTickInterval(TickInterval);
+	GetMesh()->SetComponentTickInterval(TickInterval);
+
+	// the deploy glide keeps physics off on its own
+	const bool bKinematic = NewLOD == EVehicleSimLOD::Kinematic;
+	if (bKinematic != (OldLOD == EVehicleSimLOD::Kinematic) && !bKinematicGlide)
+	{
+		const FVector Velocity = GetVelocity();
+		ChaosVehicleMovement->SetComponentTickEnabled(!bKinematic);
+		GetMesh()->SetSimulatePhysics(!bKinematic);
+		if (!bKinematic)
+		{
+			// hand the interpolated motion back to physics
+			GetMesh()->SetPhysicsLinearVelocity(Velocity);
+			if (SnapshotSamples.Num() > 0)
+			{
+				GetMesh()->SetPhysicsAngularVelocityInDegrees(SnapshotSamples.Last().AngularVelocity);
+			}
+		}
+	}
+}
+
+void AUrbanCarnagePawn::SetWheelClasses(const TArray<TSubclassOf<UChaosVehicleWheel>>& WheelClasses)
+{
+	const int32 NumWheels = FMath::Min(WheelClasses.Num(), ChaosVehicleMovement->WheelSetups.Num());
+	for (int32 WheelIndex = 0; WheelIndex < NumWheels; ++WheelIndex)
+	{
+		if (WheelClasses[WheelIndex] && ChaosVehicleMovement->WheelSetups[WheelIndex].WheelClass != WheelClasses[WheelIndex])
+		{
+			ChaosVehicleMovement->SetWheelClass(WheelIndex, WheelClasses[WheelIndex]);
+		}
+	}
+}
+
+void AUrbanCarnagePawn::PostNetReceiveVelocity(const FVector& NewVelocity)
+{
+	Super::PostNetReceiveVelocity(NewVelocity);
+	if (bKinematicGlide)
+	{
+		GlideVelocity = NewVelocity;
+	}
+}
+
+void AUrbanCarnagePawn::OnRep_ReplicatedMovement()
+{
+	Super::OnRep_ReplicatedMovement();
+	// the engine only applies non physics movement to simulated proxies, the owner glides too
+	if (bKinematicGlide && GetLocalRole() == ROLE_AutonomousProxy && !GetReplicatedMovement().bRepPhysics)
+	{
+		PostNetReceiveVelocity(GetReplicatedMovement().LinearVelocity);
+		PostNetReceiveLocationAndRotation();
+	}
+}
+
+void AUrbanCarnagePawn::PreReplication(IRepChangedPropertyTracker& ChangedPropertyTracker)
+{
+	Super::PreReplication(ChangedPropertyTracker);
+	DOREPLIFETIME_ACTIVE_OVERRIDE_FAST(AUrbanCarnagePawn, PrimaryWeapon_Ref, !bUseWeaponComponent);
+	DOREPLIFETIME_ACTIVE_OVERRIDE_FAST(AUrbanCarnagePawn, SecondaryWeapon_Ref1, !bUseWeaponComponent);
+	DOREPLIFETIME_ACTIVE_OVERRIDE_FAST(AUrbanCarnagePawn, SecondaryWeapon_Ref2, !bUseWeaponComponent);
+	const USkeletalMeshComponent* VehicleMesh = GetMesh();
+	FVehicleSnapshot Snapshot;
+	Snapshot.Location = GetActorLocation();
+	Snapshot.Rotation = GetActorRotation();
+	Snapshot.LinearVelocity = GetVelocity();
+	Snapshot.AngularVelocity = VehicleMesh->IsSimulatingPhysics()
+		? VehicleMesh->GetPhysicsAngularVelocityInDegrees()
+		: FVector(0.0f, 0.0f, FMath::RadiansToDegrees(bKinematicGlide ? GlideYawRate : 0.0f));
+	Snapshot.Input.SetSteering(ChaosVehicleMovement->GetSteeringInput());
+	Snapshot.Input.SetThrottle(ChaosVehicleMovement->GetThrottleInput());
+	Snapshot.Input.SetBrake(ChaosVehicleMovement->GetBrakeInput());
+	Snapshot.Input.SetFlag(FPackedVehicleInput::Flag_Handbrake, ChaosVehicleMovement->GetHandbrakeInput());
+	Snapshot.Input.SetFlag(FPackedVehicleInput::Flag_Parachute, IsParachuting);
+	Snapshot.Timestamp = FVehicleSnapshot::CompressTime(GetWorld()->GetTimeSeconds());
+	VehicleSnapshot = Snapshot;
+	MARK_PROPERTY_DIRTY_FROM_NAME(AUrbanCarnagePawn, VehicleSnapshot, this);
+}
+
+void AUrbanCarnagePawn::UpdateSnapshotRate()
+{
+	const double Now = GetWorld()->GetTimeSeconds();
+	if (Now < NextSnapshotRateUpdateTime) return;
+	NextSnapshotRateUpdateTime = Now + 0.25;
+
+	// parked vehicles barely change, fast ones need every update to stay smooth
+	const float Alpha = SnapshotMaxRateSpeed > 0.0f ? FMath::Clamp((float)GetVelocity().Size() / SnapshotMaxRateSpeed, 0.0f, 1.0f) : 1.0f;
+	const float Frequency = FMath::Lerp(MinSnapshotRate, MaxSnapshotRate, Alpha);
+	SetNetUpdateFrequency(Frequency);
+	const UNetDriver* NetDriver = GetNetDriver();
+	if (UUrbanCarnageReplicationGraph* ReplicationGraph = NetDriver ? Cast<UUrbanCarnageReplicationGraph>(NetDriver->GetReplicationDriver()) : nullptr)
+	{
+		ReplicationGraph->SetVehicleUpdateFrequency(this, Frequency);
+	}
+}
+
+void AUrbanCarnagePawn::OnRep_VehicleSnapshot()
+{
+	const double Now = GetWorld()->GetTimeSeconds();
+	FSnapshotSample Sample;
+	Sample.Location = VehicleSnapshot.Location;
+	Sample.Rotation = VehicleSnapshot.Rotation.Quaternion();
+	Sample.LinearVelocity = VehicleSnapshot.LinearVelocity;
+	Sample.AngularVelocity = VehicleSnapshot.AngularVelocity;
+	// the 16-bit timestamp cannot be unwrapped across a long silence, start over
+	if (SnapshotSamples.Num() > 0 && Now - LastSnapshotReceiveTime > 30.0)
+	{
+		SnapshotSamples.Reset();
+	}
+	if (SnapshotSamples.Num() == 0)
+	{
+		Sample.Time = 0.0;
+		SnapshotPlaybackTime = -SnapshotInterpolationDelay;
+		SnapshotInterval = 0.0f;
+	}
+	else
+	{
+		// unwrap the 16-bit millisecond timestamp against the previous sample
+		const FSnapshotSample& Last = SnapshotSamples.Last();
+		const double Delta = VehicleSnapshot.GetDeltaMs(LastReceivedSnapshotTimestamp) / 1000.0;
+		Sample.Time = Last.Time + Delta;
+		SnapshotInterval = SnapshotInterval > 0.0f ? FMath::Lerp(SnapshotInterval, (float)Delta, 0.2f) : (float)Delta;
+	}
+	LastReceivedSnapshotTimestamp = VehicleSnapshot.Timestamp;
+	LastSnapshotReceiveTime = Now;
+	if (SnapshotSamples.Num() == MaxSnapshotSamples)
+	{
+		SnapshotSamples.RemoveAt(0, 1, EAllowShrinking::No);
+	}
+	SnapshotSamples.Add(Sample);
+
+	// simulated proxies have no brake input of their own
+	const bool bBraking = VehicleSnapshot.Input.GetBrake() > 0.0f;
+	if (bBraking != bSnapshotBraking)
+	{
+		bSnapshotBraking = bBraking;
+		BrakeLights(bBraking);
+	}
+}
+
+void AUrbanCarnagePawn::UpdateSnapshotInterpolation(float Delta)
+{
+	if (SnapshotSamples.Num() == 0) return;
+	const FSnapshotSample& Newest = SnapshotSamples.Last();
+	// render at least one send interval behind so a lowered send rate does not run dry
+	const double Delay = FMath::Max(SnapshotInterpolationDelay, SnapshotInterval * 1.5f);
+	// drift toward the target delay instead of jumping, then bound catch up and extrapolation
+	const double Drift = FMath::Clamp(Newest.Time - Delay - SnapshotPlaybackTime, -0.1, 0.1);
+	SnapshotPlaybackTime += Delta * (1.0 + Drift);
+	SnapshotPlaybackTime = FMath::Clamp(SnapshotPlaybackTime, Newest.Time - Delay * 3.0, Newest.Time + MaxSnapshotExtrapolationTime);
+
+	if (SnapshotPlaybackTime >= Newest.Time)
+	{
+		const float Extrapolation = (float)(SnapshotPlaybackTime - Newest.Time);
+		const FQuat DeltaRotation = FQuat::MakeFromRotationVector(FVector::DegreesToRadians(Newest.AngularVelocity) * Extrapolation);
+		ApplySnapshotState(Newest.Location + Newest.LinearVelocity * Extrapolation, DeltaRotation * Newest.Rotation, Newest.LinearVelocity, Newest.AngularVelocity);
+		return;
+	}
+
+	const FSnapshotSample* From = &SnapshotSamples[0];
+	const FSnapshotSample* To = &SnapshotSamples[0];
+	for (const FSnapshotSample& Sample : SnapshotSamples)
+	{
+		To = &Sample;
+		if (Sample.Time >= SnapshotPlaybackTime) break;
+		From = &Sample;
+	}
+	const double Span = To->Time - From->Time;
+	const float Alpha = Span > KINDA_SMALL_NUMBER ? FMath::Clamp((float)((SnapshotPlaybackTime - From->Time) / Span), 0.0f, 1.0f) : 1.0f;
+	// cubic through both samples with their velocities as tangents, follows curves a lerp would cut
+	const FVector Location = FMath::CubicInterp(From->Location, From->LinearVelocity * Span, To->Location, To->LinearVelocity * Span, Alpha);
+	const FQuat Rotation = FQuat::Slerp(From->Rotation, To->Rotation, Alpha);
+	ApplySnapshotState(Location, Rotation, FMath::Lerp(From->LinearVelocity, To->LinearVelocity, Alpha), FMath::Lerp(From->AngularVelocity, To->AngularVelocity, Alpha));
+}
+
+void AUrbanCarnagePawn::ApplySnapshotState(const FVector& Location, const FQuat& Rotation, const FVector& LinearVelocity, const FVector& AngularVelocity)
+{
+	USkeletalMeshComponent* VehicleMesh = GetMesh();
+	if (!VehicleMesh->IsSimulatingPhysics())
+	{
+		// Kinematic LOD and deploy glide, the snapshots are the movement
+		VehicleMesh->ComponentVelocity = LinearVelocity;
+		SetActorLocationAndRotation(Location, Rotation, false, nullptr, ETeleportType::TeleportPhysics);
+		return;
+	}
+
+	const FVector LocationError = Location - GetActorLocation();
+	if (LocationError.SizeSquared() > FMath::Square(SnapshotSnapDistance))
+	{
+		SetActorLocationAndRotation(Location, Rotation, false, nullptr, ETeleportType::TeleportPhysics);
+		VehicleMesh->SetPhysicsLinearVelocity(LinearVelocity);
+		VehicleMesh->SetPhysicsAngularVelocityInDegrees(AngularVelocity);
+		return;
+	}
+	// steer the simulation toward the snapshot through its velocity, contacts and wheels stay physical
+	FQuat RotationError = Rotation * GetActorQuat().Inverse();
+	RotationError.EnforceShortestArcWith(FQuat::Identity);
+	VehicleMesh->SetPhysicsLinearVelocity(LinearVelocity + LocationError * SnapshotCorrectionRate);
+	VehicleMesh->SetPhysicsAngularVelocityInRadians(FVector::DegreesToRadians(AngularVelocity) + RotationError.ToRotationVector() * SnapshotCorrectionRate);
+}
+
+AWeaponBase* AUrbanCarnagePawn::EquipWeapon(TSubclassOf<AWeaponBase> WeaponClass, bool PrimaryWeapon)
+{
+	if (bUseWeaponComponent)
+	{
+		// same slot order as below, the secondary weapons fill slot 2 first
+		const int32 Slot = PrimaryWeapon ? (PrimaryWeapon_Ref ? INDEX_NONE : 0)
+			: (!SecondaryWeapon_Ref2 ? 2 : (!SecondaryWeapon_Ref1 ? 1 : INDEX_NONE));
+		return Slot != INDEX_NONE ? WeaponsComponent->SetWeapon(Slot, WeaponClass) : nullptr;
+	}
+	// the owner has to be set at spawn so the replication graph can register the weapon as our dependent
+	FActorSpawnParameters SpawnParams;
+	SpawnParams.Owner = this;
+	if (PrimaryWeapon)
+	{
+		if (PrimaryWeapon_Ref)return nullptr;
+		
+		PrimaryWeapon_Ref = GetWorld()->SpawnActor<AWeaponBase>(WeaponClass, PrimaryWeaponSlot->GetComponentLocation(), PrimaryWeaponSlot->GetComponentRotation(), SpawnParams);
+		//attach primaryweapon_ref to the primaryweaponslot
+		PrimaryWeapon_Ref->AttachToComponent(PrimaryWeaponSlot, FAttachmentTransformRules::SnapToTargetNotIncludingScale);
+		PrimaryWeapon_Ref->SetOwner(this);
+		MARK_PROPERTY_DIRTY_FROM_NAME(AUrbanCarnagePawn, PrimaryWeapon_Ref, this);
+		return PrimaryWeapon_Ref;
+	}
+	else
+	{
+	//check if we have any secondary weapon and attach to the available slot else return false
+		if (!SecondaryWeapon_Ref2)
+		{
+			SecondaryWeapon_Ref2 = GetWorld()->SpawnActor<AWeaponBase>(WeaponClass, SecondaryWeaponSlot2->GetComponentLocation(), SecondaryWeaponSlot2->GetComponentRotation(), SpawnParams);
+			//attach secondaryweapon_ref2 to the secondaryweaponslot2
+			SecondaryWeapon_Ref2->AttachToComponent(SecondaryWeaponSlot2, FAttachmentTransformRules::SnapToTargetNotIncludingScale);
+			SecondaryWeapon_Ref2->SetOwner(this);
+			MARK_PROPERTY_DIRTY_FROM_NAME(AUrbanCarnagePawn, SecondaryWeapon_Ref2, this);
+			return SecondaryWeapon_Ref2;
+		}
+		else if (!SecondaryWeapon_Ref1)
+		{
+			SecondaryWeapon_Ref1 = GetWorld()->SpawnActor<AWeaponBase>(WeaponClass, SecondaryWeaponSlot1->GetComponentLocation(), SecondaryWeaponSlot1->GetComponentRotation(), SpawnParams);
+			//attach secondaryweapon_ref1 to the secondaryweaponslot1
+			SecondaryWeapon_Ref1->AttachToComponent(SecondaryWeaponSlot1, FAttachmentTransformRules::SnapToTargetNotIncludingScale);
+			SecondaryWeapon_Ref1->SetOwner(this);
+			MARK_PROPERTY_DIRTY_FROM_NAME(AUrbanCarnagePawn, SecondaryWeapon_Ref1, this);
+			return SecondaryWeapon_Ref1;
+		}
+		return nullptr;
+	}
+	
+}
+
+void AUrbanCarnagePawn::Steering(const FInputActionValue& Value)
+{
+	// get the input magnitude for steering
+	float SteeringValue = Value.Get<float>();
+
+	// add the input
+	ChaosVehicleMovement->SetSteeringInput(SteeringValue);
+	PendingInput.SetSteering(SteeringValue);
+}
+
+void AUrbanCarnagePawn::Throttle(const FInputActionValue& Value)
+{
+	// get the input magnitude for the throttle
+	float ThrottleValue = Value.Get<float>();
+
+	// add the input
+	ChaosVehicleMovement->SetThrottleInput(ThrottleValue);
+	PendingInput.SetThrottle(ThrottleValue);
+}
+
+void AUrbanCarnagePawn::Brake(const FInputActionValue& Value)
+{
+	// get the input magnitude for the brakes
+	float BreakValue = Value.Get<float>();
+
+	// add the input
+	ChaosVehicleMovement->SetBrakeInput(BreakValue);
+	PendingInput.SetBrake(BreakValue);
+}
+
+void AUrbanCarnagePawn::StartBrake(const FInputActionValue& Value)
+{
+	float VehicleSpeed = ChaosVehicleMovement->GetForwardSpeed();
+	
+	
+	if ( VehicleSpeed > 0.0f)
+	{
+		BrakeLights(true);
+	}
+	if ( VehicleSpeed <= 0.0f)
+	{
+		BrakeLights(false);
+	}
+	
+	// call the Blueprint hook for the break lights
+
+}
+
+void AUrbanCarnagePawn::StopBrake(const FInputActionValue& Value)
+{
+	// call the Blueprint hook for the break lights
+	BrakeLights(false);
+
+	// reset brake input to zero
+	ChaosVehicleMovement->SetBrakeInput(0.0f);
+	PendingInput.SetBrake(0.0f);
+}
+
+void AUrbanCarnagePawn::StartHandbrake(const FInputActionValue& Value)
+{
+	// add the input
+	ChaosVehicleMovement->SetHandbrakeInput(true);
+
+	// call the Blueprint hook for the break lights
+	//BrakeLights(true);
+	PendingInput.SetFlag(FPackedVehicleInput::Flag_Handbrake, true);
+	// the parachute stays requested until the vehicle lands
+	if (bIsInAir)
+	{
+		PendingInput.SetFlag(FPackedVehicleInput::Flag_Parachute, true);
+	}
+}
+
+void AUrbanCarnagePawn::StopHandbrake(const FInputActionValue& Value)
+{
+	// add the input
+	ChaosVehicleMovement->SetHandbrakeInput(false);
+	PendingInput.SetFlag(FPackedVehicleInput::Flag_Handbrake, false);
+
+	// call the Blueprint hook for the break lights
+	//BrakeLights(false);
+}
+
+void AUrbanCarnagePawn::LookAround(const FInputActionValue& Value)
+{
+	// get value for looking around as 2D vector
+	
+	FVector2D LookValue = Value.Get<FVector2D>();
+
+	// add the input
+	AddControllerPitchInput(-LookValue.Y);
+	AddControllerYawInput(LookValue.X);
+
+}
+
+
+void AUrbanCarnagePawn::ResetVehicle(const FInputActionValue& Value)
+{
+	// reset to a location slightly above our current one
+	FVector ResetLocation = GetActorLocation() + FVector(0.0f, 0.0f, 50.0f);
+
+	// reset to our yaw. Ignore pitch and roll
+	FRotator ResetRotation = GetActorRotation();
+	ResetRotation.Pitch = 0.0f;
+	ResetRotation.Roll = 0.0f;
+	
+	// teleport the actor to the reset spot and reset physics
+	SetActorTransform(FTransform(ResetRotation, ResetLocation, FVector::OneVector), false, nullptr, ETeleportType::TeleportPhysics);
+
+	GetMesh()->SetPhysicsAngularVelocityInDegrees(FVector::ZeroVector);
+	GetMesh()->SetPhysicsLinearVelocity(FVector::ZeroVector);
+
+	UE_LOG(LogTemplateVehicle, Error, TEXT("Reset Vehicle"));
+}
+
 #undef LOCTEXT_NAMESPACE
\ No newline at end of file
@@ -1,222 +1,480 @@
-// Copyright Epic Games, Inc. All Rights Reserved.
-
-#pragma once
-
-#include "CoreMinimal.h"
-#include "WeaponBase.h"
-#include "WheeledVehiclePawn.h"
-#include "Core/BulletBase.h"
-#include "UrbanCarnagePawn.generated.h"
-
-class UArrowComponent;
-class UCameraComponent;
-class USpringArmComponent;
-class UInputAction;
-class UChaosWheeledVehicleMovementComponent;
-struct FInputActionValue;
-
-DECLARE_LOG_CATEGORY_EXTERN(LogTemplateVehicle, Log, All);
-
-/**
- *  Vehicle Pawn class
- *  Handles common functionality for all vehicle types,
- *  including input handling and camera management.
- *  
- *  Specific vehicle configurations are handled in subclasses.
- */
-UCLASS(abstract)
-class AUrbanCarnagePawn : public AWheeledVehiclePawn
-{
-	GENERATED_BODY()
-
-	
-	/** Spring Arm for the back camera */
-	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = Camera, meta = (AllowPrivateAccess = "true"))
-	USpringArmComponent* BackSpringArm;
-
-	/** Back Camera component */
-	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = Camera, meta = (AllowPrivateAccess = "true"))
-	UCameraComponent* BackCamera;
-
-	/** Cast pointer to the Chaos Vehicle movement component */
-	TObjectPtr<UChaosWheeledVehicleMovementComponent> ChaosVehicleMovement;
-
-	//add abilitysystem componenet
-	
-
-protected:
-
-	/** Steering Action */
-	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = Input)
-	UInputAction* SteeringAction;
-
-	/** Throttle Action */
-	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = Input)
-	UInputAction* ThrottleAction;
-
-	/** Brake Action */
-	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = Input)
-	UInputAction* BrakeAction;
-
-	/** Handbrake Action */
-	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = Input)
-	UInputAction* HandbrakeAction;
-
-	/** Look Around Action */
-	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = Input)
-	UInputAction* LookAroundAction;
-
-	/** Toggle Camera Action */
-	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = Input)
-	UInputAction* ToggleCameraAction;
-
-	/** Reset Vehicle Action */
-	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = Input)
-	UInputAction* ResetVehicleAction;
-
-	
-public:
-	AUrbanCarnagePawn();
-
-	// Begin Pawn interface
-	void GetLifetimeReplicatedProps(TArray<class FLifetimeProperty>& OutLifetimeProps) const override;
-	virtual void SetupPlayerInputComponent(UInputComponent* InputComponent) override;
-
-	// End Pawn interface
-
-	// Begin Actor interface
-
-	virtual void Tick(float Delta) override;
-
-	virtual void BeginPlay() override;
-	
-	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Vehicle")
-	class UAbilitySystemComponent* AbilitySystemComponent;
-	//add initial abilities
-	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Vehicle")
-	TArray<TSubclassOf<class UGameplayAbility>> InitialAbilities;
-	UFUNCTION(BlueprintCallable)
-	AWeaponBase* EquipWeapon(TSubclassOf<AWeaponBase> WeaponClass, bool PrimaryWeapon);
-	
-
-protected:
-
-	/** Handles steering input */
-	void Steering(const FInputActionValue& Value);
-
-	/** Handles throttle input */
-	void Throttle(const FInputActionValue& Value);
-
-	/** Handles brake input */
-	void Brake(const FInputActionValue& Value);
-
-	/** Handles brake start/stop inputs */
-	void StartBrake(const FInputActionValue& Value);
-	void StopBrake(const FInputActionValue& Value);
-
-	/** Handles handbrake start/stop inputs */
-	void StartHandbrake(const FInputActionValue& Value);
-	void StopHandbrake(const FInputActionValue& Value);
-
-	/** Handles look around input */
-	void LookAround(const FInputActionValue& Value);
-	
-	/** Handles reset vehicle input */
-	void ResetVehicle(const FInputActionValue& Value);
-
-	/** Called when the brake lights are turned on or off */
-	UFUNCTION(BlueprintImplementableEvent, Category="Vehicle")
-	void BrakeLights(bool bBraking);
-
-public:
-	/** Returns the back spring arm subobject */
-	FORCEINLINE USpringArmComponent* GetBackSpringArm() const { return BackSpringArm; }
-	/** Returns the back camera subobject */
-	FORCEINLINE UCameraComponent* GetBackCamera() const { return BackCamera; }
-	/** Returns the cast Chaos Vehicle Movement subobject */
-	FORCEINLINE const TObjectPtr<UChaosWheeledVehicleMovementComponent>& GetChaosVehicleMovement() const { return ChaosVehicleMovement; }
-
-	UPROPERTY(EditAnywhere, BlueprintReadWrite , Category = "Vehicle",Replicated)
-	TSubclassOf<ABulletBase> BulletClass;
-	UPROPERTY(EditAnywhere, BlueprintReadWrite , Category = "Vehicle")
-	UInputAction* FireAction;
-	UPROPERTY(EditAnywhere, BlueprintReadWrite , Category = "Vehicle")
-	TSubclassOf<AWeaponBase> PrimaryWeaponClass;
-	UPROPERTY(EditAnywhere, BlueprintReadWrite , Category = "Vehicle")
-	TSubclassOf<AWeaponBase> SecondaryWeaponClass;
-	UPROPERTY(EditAnywhere, BlueprintReadWrite , Category = "Vehicle")
-	USceneComponent* PrimaryWeaponSlot;
-	UPROPERTY(EditAnywhere, BlueprintReadWrite , Category = "Vehicle")
-	USceneComponent* SecondaryWeaponSlot1;
-	UPROPERTY(EditAnywhere, BlueprintReadWrite , Category = "Vehicle")
-	USceneComponent* SecondaryWeaponSlot2;
-	UPROPERTY(EditAnywhere, BlueprintReadWrite , Category = "Vehicle",Replicated)
-	AWeaponBase* PrimaryWeapon_Ref;
-	UPROPERTY(EditAnywhere, BlueprintReadWrite , Category = "Vehicle",Replicated)
-	AWeaponBase* SecondaryWeapon_Ref1;
-	UPROPERTY(EditAnywhere, BlueprintReadWrite , Category = "Vehicle",Replicated)
-	AWeaponBase* SecondaryWeapon_Ref2;
-	UPROPERTY(EditAnywhere, BlueprintReadWrite , Category = "Vehicle",Replicated)
-	bool bIsInAir;
-	
-	UFUNCTION()
-	void Fire(const FInputActionValue& Value);
-	UFUNCTION(Server, Reliable)
-	void Server_Fire();
-
-	
-	UFUNCTION(BlueprintCallable)
-	void SetDeployMode(bool bDeploy);
-	UPROPERTY(Replicated)
-	float AirSpeedMultiplier=1.0f;
-	UPROPERTY(Replicated)
-	float AirTurnMultipler=0.0f;
-	UFUNCTION(Server,Unreliable)
-	void Server_SetAirSpeedMultiplier(float _AirSpeedMultiplier);
-	UFUNCTION(Server,Unreliable)
-	void Server_SetAirTurnMultiplier(float _AirTurnMultiplier);
-
-	void CheckForGround();
-	UPROPERTY(Replicated)
-	bool IsParachuting=false;
-	UFUNCTION(Server,Unreliable)
-	void Server_SetParachuting(bool bParachuting);
-	UFUNCTION(NetMulticast,Unreliable)
-	void OpenParachutEffect_MC(bool Start);
-	UFUNCTION(BlueprintImplementableEvent)
-	void OpenParachutEffect_BP();
-	UFUNCTION(BlueprintImplementableEvent)
-	void StopParachutEffect_BP();
-	UFUNCTION(NetMulticast,Unreliable)
-	void DeployEffect_MC(bool Start);
-	UFUNCTION(BlueprintImplementableEvent)
-	void deployEffect_BP();
-	UFUNCTION(BlueprintImplementableEvent)
-	void StopDeployEffect_BP();
-	//Dynamic Aiming sys------------------------
-	UFUNCTION()
-	void CalculateAimLocation();
-	
-	UPROPERTY(Replicated)
-	FVector AimPoint;
-	
-	UFUNCTION(Server,Reliable)
-	void Server_SetAimLocation(FVector _AimPoint);
-	
-	//-------------------------------------------
-	void Death();
-	virtual void Destroyed() override;
-	UFUNCTION(NetMulticast,Unreliable)
-	void DestroyEffect_MC();
-	UFUNCTION(BlueprintImplementableEvent)
-	void DestroyEffect_BP();
-	bool isDead=false;
-	UPROPERTY(BlueprintReadWrite)
-	bool b_CanAim=true;
-};
-
-
-
-
-
-	
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "WeaponBase.h"
+#include "WheeledVehiclePawn.h"
+#include "Core/BulletBase.h"
+#include "UrbanCarnageNetTypes.h"
+#include "WorldCollision.h"
+#include "UrbanCarnagePawn.generated.h"
+
+class UArrowComponent;
+class UCameraComponent;
+class USpringArmComponent;
+class UInputAction;
+class UChaosWheeledVehicleMovementComponent;
+class UChaosVehicleWheel;
+struct FInputActionValue;
+
+DECLARE_LOG_CATEGORY_EXTERN(LogTemplateVehicle, Log, All);
+
+/** How much of the vehicle simulation runs on this machine, picked from the significance to the local camera */
+UENUM(BlueprintType)
+enum class EVehicleSimLOD : uint8
+{
+	/** Full Chaos simulation with the regular wheels */
+	Full,
+	/** Chaos simulation with ReducedLODWheelClasses and a lower component tick rate */
+	Reduced,
+	/** No physics, the vehicle is placed along the interpolated snapshots. Simulated proxies only */
+	Kinematic,
+};
+
+/**
+ *  Vehicle Pawn class
+ *  Handles common functionality for all vehicle types,
+ *  including input handling and camera management.
+ *  
+ *  Specific vehicle configurations are handled in subclasses.
+ */
+UCLASS(abstract)
+class AUrbanCarnagePawn : public AWheeledVehiclePawn
+{
+	GENERATED_BODY()
+
+	
+	/** Spring Arm for the back camera */
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = Camera, meta = (AllowPrivateAccess = "true"))
+	USpringArmComponent* BackSpringArm;
+
+	/** Back Camera component */
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = Camera, meta = (AllowPrivateAccess = "true"))
+	UCameraComponent* BackCamera;
+
+	/** Cast pointer to the Chaos Vehicle movement component */
+	TObjectPtr<UChaosWheeledVehicleMovementComponent> ChaosVehicleMovement;
+
+	//add abilitysystem componenet
+	
+
+protected:
+
+	/** Steering Action */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = Input)
+	UInputAction* SteeringAction;
+
+	/** Throttle Action */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = Input)
+	UInputAction* ThrottleAction;
+
+	/** Brake Action */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = Input)
+	UInputAction* BrakeAction;
+
+	/** Handbrake Action */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = Input)
+	UInputAction* HandbrakeAction;
+
+	/** Look Around Action */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = Input)
+	UInputAction* LookAroundAction;
+
+	/** Toggle Camera Action */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = Input)
+	UInputAction* ToggleCameraAction;
+
+	/** Reset Vehicle Action */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = Input)
+	UInputAction* ResetVehicleAction;
+
+	
+public:
+	AUrbanCarnagePawn();
+
+	// Begin Pawn interface
+	void GetLifetimeReplicatedProps(TArray<class FLifetimeProperty>& OutLifetimeProps) const override;
+	virtual void SetupPlayerInputComponent(UInputComponent* InputComponent) override;
+
+	// End Pawn interface
+
+	// Begin Actor interface
+
+	virtual void BeginPlay() override;
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
+	
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Vehicle")
+	class UAbilitySystemComponent* AbilitySystemComponent;
+	//add initial abilities
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Vehicle")
+	TArray<TSubclassOf<class UGameplayAbility>> InitialAbilities;
+	UFUNCTION(BlueprintCallable)
+	AWeaponBase* EquipWeapon(TSubclassOf<AWeaponBase> WeaponClass, bool PrimaryWeapon);
+
+	/** Replicates the weapons through our own channel when bUseWeaponComponent is set */
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Vehicle")
+	class UVehicleWeaponsComponent* WeaponsComponent;
+	/**
+	 * If true, EquipWeapon gives the weapons to WeaponsComponent, each machine spawns its own copy and the
+	 * weapon actors do not replicate. Otherwise every weapon is a replicated actor with its own channel.
+	 */
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Vehicle")
+	bool bUseWeaponComponent = true;
+	
+
+protected:
+
+	/** Handles steering input */
+	void Steering(const FInputActionValue& Value);
+
+	/** Handles throttle input */
+	void Throttle(const FInputActionValue& Value);
+
+	/** Handles brake input */
+	void Brake(const FInputActionValue& Value);
+
+	/** Handles brake start/stop inputs */
+	void StartBrake(const FInputActionValue& Value);
+	void StopBrake(const FInputActionValue& Value);
+
+	/** Handles handbrake start/stop inputs */
+	void StartHandbrake(const FInputActionValue& Value);
+	void StopHandbrake(const FInputActionValue& Value);
+
+	/** Handles look around input */
+	void LookAround(const FInputActionValue& Value);
+	
+	/** Handles reset vehicle input */
+	void ResetVehicle(const FInputActionValue& Value);
+
+	/** Called when the brake lights are turned on or off */
+	UFUNCTION(BlueprintImplementableEvent, Category="Vehicle")
+	void BrakeLights(bool bBraking);
+
+public:
+	/** Returns the back spring arm subobject */
+	FORCEINLINE USpringArmComponent* GetBackSpringArm() const { return BackSpringArm; }
+	/** Returns the back camera subobject */
+	FORCEINLINE UCameraComponent* GetBackCamera() const { return BackCamera; }
+	/** Wheel classes used at Reduced LOD, one per wheel setup, empty keeps the regular wheels */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Vehicle|LOD")
+	TArray<TSubclassOf<UChaosVehicleWheel>> ReducedLODWheelClasses;
+	/** Tick interval of the movement and mesh components below Full LOD */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Vehicle|LOD")
+	float ReducedLODTickInterval = 0.05f;
+	/** Seconds a vehicle stays Kinematic, without firing, before its local weapon copies are destroyed */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Vehicle|LOD")
+	float WeaponCopiesSuspendDelay = 5.0f;
+
+	/** Switches the simulation LOD, locally controlled vehicles stay Full and authority never goes Kinematic */
+	void SetSimulationLOD(EVehicleSimLOD NewLOD);
+	EVehicleSimLOD GetSimulationLOD() const { return SimulationLOD; }
+	/** LOD picked by the significance manager, the vehicle tick subsystem applies it once the current one was held long enough */
+	void RequestSimulationLOD(EVehicleSimLOD NewLOD) { RequestedSimulationLOD = NewLOD; }
+	EVehicleSimLOD GetRequestedSimulationLOD() const { return RequestedSimulationLOD; }
+	/** World time of the last SetSimulationLOD that changed the LOD */
+	double GetSimulationLODChangeTime() const { return SimulationLODChangeTime; }
+	/** Suspends the local weapon copies of a vehicle that stayed Kinematic for WeaponCopiesSuspendDelay, called by the vehicle tick subsystem */
+	void UpdateWeaponCopiesSuspension();
+
+	virtual void PostNetReceiveVelocity(const FVector& NewVelocity) override;
+	virtual void OnRep_ReplicatedMovement() override;
+	virtual void PreReplication(IRepChangedPropertyTracker& ChangedPropertyTracker) override;
+
+	/** Movement state for simulated proxies, written in PreReplication so it is only built when sent */
+	UPROPERTY(ReplicatedUsing = OnRep_VehicleSnapshot)
+	FVehicleSnapshot VehicleSnapshot;
+	UFUNCTION()
+	void OnRep_VehicleSnapshot();
+
+	/** How far behind the newest snapshot simulated proxies render at least, in seconds */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Vehicle|Replication")
+	float SnapshotInterpolationDelay = 0.1f;
+	/** How long simulated proxies extrapolate past the newest snapshot before they hold still */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Vehicle|Replication")
+	float MaxSnapshotExtrapolationTime = 0.25f;
+	/** Simulated proxies further than this from the snapshot state are teleported instead of steered */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Vehicle|Replication")
+	float SnapshotSnapDistance = 500.0f;
+	/** Fraction of the position and rotation error a simulating proxy corrects per second */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Vehicle|Replication")
+	float SnapshotCorrectionRate = 8.0f;
+	/** Snapshot send rate of a parked vehicle and of one at SnapshotMaxRateSpeed, in Hz */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Vehicle|Replication")
+	float MinSnapshotRate = 5.0f;
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Vehicle|Replication")
+	float MaxSnapshotRate = 30.0f;
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Vehicle|Replication")
+	float SnapshotMaxRateSpeed = 3000.0f;
+
+	/** Server side, adapts the send rate to the speed of the vehicle, called by the vehicle tick subsystem */
+	void UpdateSnapshotRate();
+	/** Moves a simulated proxy along the snapshot buffer, called by the vehicle tick subsystem */
+	void UpdateSnapshotInterpolation(float Delta);
+
+protected:
+	EVehicleSimLOD SimulationLOD = EVehicleSimLOD::Full;
+	EVehicleSimLOD RequestedSimulationLOD = EVehicleSimLOD::Full;
+	double SimulationLODChangeTime = 0.0;
+	/** World time of the last shots a simulated proxy received, firing keeps its weapon copies around */
+	double LastShotsFiredTime = 0.0;
+	/** Wheel classes from the wheel setups, restored at Full LOD */
+	TArray<TSubclassOf<UChaosVehicleWheel>> FullLODWheelClasses;
+
+	struct FSnapshotSample
+	{
+		double Time;
+		FVector Location;
+		FQuat Rotation;
+		FVector LinearVelocity;
+		FVector AngularVelocity;
+	};
+	static constexpr int32 MaxSnapshotSamples = 8;
+	/** Received snapshots, oldest first, times in unwrapped server seconds */
+	TArray<FSnapshotSample, TInlineAllocator<MaxSnapshotSamples>> SnapshotSamples;
+	double SnapshotPlaybackTime = 0.0;
+	uint16 LastReceivedSnapshotTimestamp = 0;
+	double LastSnapshotReceiveTime = 0.0;
+	/** Smoothed time between two received snapshots, the interpolation delay grows with it */
+	float SnapshotInterval = 0.0f;
+	double NextSnapshotRateUpdateTime = 0.0;
+	bool bSnapshotBraking = false;
+
+	/** Moves the vehicle to a snapshot state, through the physics velocity while it simulates */
+	void ApplySnapshotState(const FVector& Location, const FQuat& Rotation, const FVector& LinearVelocity, const FVector& AngularVelocity);
+
+	void SetWheelClasses(const TArray<TSubclassOf<UChaosVehicleWheel>>& WheelClasses);
+
+	/** Turns the Chaos simulation off for the deploy glide, or back on with the glide velocity */
+	void SetKinematicGlide(bool bGlide);
+	bool bKinematicGlide = false;
+	FVector GlideVelocity = FVector::ZeroVector;
+	/** Yaw rate of the glide in rad/s */
+	float GlideYawRate = 0.0f;
+	float GlideMass = 1.0f;
+
+public:
+	/** Returns the cast Chaos Vehicle Movement subobject */
+	FORCEINLINE const TObjectPtr<UChaosWheeledVehicleMovementComponent>& GetChaosVehicleMovement() const { return ChaosVehicleMovement; }
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite , Category = "Vehicle",Replicated)
+	TSubclassOf<ABulletBase> BulletClass;
+	UPROPERTY(EditAnywhere, BlueprintReadWrite , Category = "Vehicle")
+	UInputAction* FireAction;
+	UPROPERTY(EditAnywhere, BlueprintReadWrite , Category = "Vehicle")
+	TSubclassOf<AWeaponBase> PrimaryWeaponClass;
+	UPROPERTY(EditAnywhere, BlueprintReadWrite , Category = "Vehicle")
+	TSubclassOf<AWeaponBase> SecondaryWeaponClass;
+	UPROPERTY(EditAnywhere, BlueprintReadWrite , Category = "Vehicle")
+	USceneComponent* PrimaryWeaponSlot;
+	UPROPERTY(EditAnywhere, BlueprintReadWrite , Category = "Vehicle")
+	USceneComponent* SecondaryWeaponSlot1;
+	UPROPERTY(EditAnywhere, BlueprintReadWrite , Category = "Vehicle")
+	USceneComponent* SecondaryWeaponSlot2;
+	UPROPERTY(EditAnywhere, BlueprintReadWrite , Category = "Vehicle",Replicated)
+	AWeaponBase* PrimaryWeapon_Ref;
+	UPROPERTY(EditAnywhere, BlueprintReadWrite , Category = "Vehicle",Replicated)
+	AWeaponBase* SecondaryWeapon_Ref1;
+	UPROPERTY(EditAnywhere, BlueprintReadWrite , Category = "Vehicle",Replicated)
+	AWeaponBase* SecondaryWeapon_Ref2;
+	UPROPERTY(EditAnywhere, BlueprintReadWrite , Category = "Vehicle",ReplicatedUsing=OnRep_IsInAir)
+	bool bIsInAir;
+	UFUNCTION()
+	void OnRep_IsInAir();
+	
+	UFUNCTION()
+	void Fire(const FInputActionValue& Value);
+	/** Lets go of the trigger of every weapon, so a tap fires one shot and bursts end with the input */
+	UFUNCTION()
+	void StopFire(const FInputActionValue& Value);
+	/** Releases the triggers on the server too, for weapons it fires itself */
+	UFUNCTION(Server, Reliable)
+	void Server_StopFire();
+	void ReleaseWeaponTriggers();
+
+	/** Slot index of an equipped weapon (0 primary, 1 and 2 secondary), INDEX_NONE if not equipped */
+	int32 GetWeaponSlot(const AWeaponBase* Weapon) const;
+	AWeaponBase* GetWeaponInSlot(int32 Slot) const;
+	/** Scene component a weapon in Slot is attached to */
+	USceneComponent* GetWeaponSlotComponent(int32 Slot) const;
+	/** Points the weapon reference of Slot at Weapon, on every machine for the weapons component */
+	void SetWeaponInSlot(int32 Slot, AWeaponBase* Weapon);
+
+	/** Shot events fired this frame, sent as one multicast at the end of the tick */
+	TArray<FShotFiredEvent> PendingShotEvents;
+	void QueueShotEvent(const FShotFiredEvent& Shot);
+	/** Sends the pending shot events, if any */
+	void FlushShotEvents();
+	UFUNCTION(NetMulticast, Unreliable)
+	void Multicast_ShotsFired(const TArray<FShotFiredEvent>& Shots);
+
+	/** Owning client side, shots played this frame ahead of the server, sent as one RPC by FlushShotEvents */
+	TArray<FPredictedShot> PendingPredictedShots;
+	/** Tags a predicted shot with the next sequence number and queues it for the server */
+	void QueuePredictedShot(const FShotFiredEvent& Shot);
+	UFUNCTION(Server, Unreliable)
+	void Server_FireShots(const TArray<FPredictedShot>& Shots);
+	/**
+	 * Acknowledges every predicted shot up to NewestSequence. Bit i of AcceptedMask is set if shot
+	 * NewestSequence - i arrived and was fired, so each ack repeats the verdicts of the 31 shots before it.
+	 * A shot without its bit was rejected or its batch was lost, the server never fired it either way.
+	 */
+	UFUNCTION(Client, Unreliable)
+	void Client_AckShots(uint16 NewestSequence, uint32 AcceptedMask);
+
+	struct FUnackedShot
+	{
+		uint16 Sequence = 0;
+		uint8 WeaponSlot = 0;
+		double FireTime = 0.0;
+	};
+	/** Owning client side, predicted shots the server has not acknowledged yet */
+	TArray<FUnackedShot> UnackedShots;
+	uint16 NextShotSequence = 0;
+	/** Unacknowledged shots count as rejected after this many seconds, neither they nor their acks got through */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Vehicle")
+	float UnackedShotTimeout = 1.0f;
+
+	/** Server side, verdicts of the predicted shots received since the last ack */
+	uint16 AckShotSequence = 0;
+	uint32 AcceptedShotMask = 0;
+	bool bShotAckPending = false;
+	bool bHasAckedShots = false;
+	void RecordShotVerdict(uint16 Sequence, bool bAccepted);
+	/** Owning client side, rejects the unacknowledged shots older than UnackedShotTimeout, called every frame by the vehicle tick subsystem */
+	void ExpireUnackedShots();
+	void RejectPredictedShot(const FUnackedShot& Unacked);
+
+	
+	UFUNCTION(BlueprintCallable)
+	void SetDeployMode(bool bDeploy);
+	UPROPERTY(Replicated)
+	float AirSpeedMultiplier=1.0f;
+	UPROPERTY(Replicated)
+	float AirTurnMultipler=0.0f;
+
+	/** Input gathered this frame by the input handlers, flushed to the server once per frame */
+	FPackedVehicleInput PendingInput;
+	/** Last input sent to the server */
+	FPackedVehicleInput LastSentInput;
+	double LastInputSendTime = -1.0;
+	/** An unchanged input is resent after this many seconds so a lost packet does not stick */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Vehicle")
+	float InputKeepAliveInterval = 0.25f;
+	UFUNCTION(Server,Unreliable)
+	void Server_SetVehicleInput(FPackedVehicleInput _Input);
+	/** Sends PendingInput to the server if it changed, only while the vehicle is in the air */
+	void FlushVehicleInput();
+	/** Server side, derives the air control multipliers and parachute state from an input packet */
+	void ApplyVehicleInput(const FPackedVehicleInput& _Input);
+
+	/** Height above the ground at which a deployed vehicle lands */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Vehicle")
+	float GroundCheckDistance = 1000.0f;
+	/** Server side, ends the deploy once the ground query service found the ground close below */
+	void LandOnGround();
+	/**
+	 * If true, a deployed vehicle glides kinematically instead of running the Chaos vehicle simulation,
+	 * physics comes back with the glide velocity when it lands
+	 */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Vehicle")
+	bool bUseKinematicDeploy = true;
+	bool IsKinematicGlide() const { return bKinematicGlide; }
+	/** Moves a gliding vehicle with the air control forces of FAirControlSimCallback, simulated proxies follow the snapshots */
+	void UpdateKinematicGlide(float Delta);
+	/** Height above the ground below the vehicle for the deploy and parachute logic, -1 if there is no ground */
+	UFUNCTION(BlueprintCallable, Category = "Vehicle")
+	float GetHeightAboveGround() const;
+	UPROPERTY(Replicated)
+	bool IsParachuting=false;
+	void SetParachuting(bool bParachuting);
+	UFUNCTION(BlueprintImplementableEvent)
+	void OpenParachutEffect_BP();
+	UFUNCTION(BlueprintImplementableEvent)
+	void StopParachutEffect_BP();
+	UFUNCTION(BlueprintImplementableEvent)
+	void deployEffect_BP();
+	UFUNCTION(BlueprintImplementableEvent)
+	void StopDeployEffect_BP();
+	//Dynamic Aiming sys------------------------
+	UFUNCTION()
+	void CalculateAimLocation();
+	
+	UPROPERTY(Replicated)
+	FVector AimPoint;
+	
+	UFUNCTION(Server,Reliable)
+	void Server_SetAimLocation(FVector _AimPoint);
+
+	/** If true, aim is streamed as quantized unreliable samples instead of the reliable Server_SetAimLocation */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Aim")
+	bool bUseQuantizedAimStream = true;
+	/** Minimum change of the aim direction in degrees before a new sample is sent */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Aim")
+	float AimSendAngleThreshold = 0.5f;
+	/** Maximum number of aim samples sent per second */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Aim")
+	float AimMaxSendRate = 20.0f;
+	/** An unchanged aim is resent after this many seconds so a lost sample does not stick */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Aim")
+	float AimKeepAliveInterval = 0.5f;
+	/** Length of the camera aim trace, also the range covered by the aim range buckets */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Aim")
+	float AimMaxRange = 90000.0f;
+	/** Interpolation speed the server uses to move between received aim samples */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Aim")
+	float AimSmoothingSpeed = 12.0f;
+
+	UFUNCTION(Server,Unreliable)
+	void Server_SetQuantizedAim(FQuantizedAim _Aim);
+
+	/** Sends the current AimPoint as a quantized sample if it changed enough */
+	void SendQuantizedAim();
+	/** Server side, smooths AimPoint towards the last received sample and aims the weapons */
+	void UpdateServerAim(float Delta);
+	/** Aims every equipped weapon at the given point */
+	void AimWeapons(const FVector& _AimPoint);
+
+	FQuantizedAim LastSentAim;
+	double LastAimSendTime = -1.0;
+	FVector AimTargetDirection = FVector::ForwardVector;
+	float AimTargetRange = 0.0f;
+	bool bHasAimTarget = false;
+
+	/** Collision channel of the camera aim trace, meant to be a trace channel that only simple collision blocks */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Aim")
+	TEnumAsByte<ECollisionChannel> AimTraceChannel = ECC_Visibility;
+	/** The last aim hit is reused while the camera moved less than this */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Aim")
+	float AimTraceReuseDistance = 10.0f;
+	/** The last aim hit is reused while the camera turned less than this many degrees */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Aim")
+	float AimTraceReuseAngle = 0.25f;
+	/** A reused aim hit is traced again after this many seconds, targets move too */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Aim")
+	float AimTraceMaxAge = 0.1f;
+
+	/** Async camera trace in flight, read back on the next frame */
+	FTraceHandle AimTraceHandle;
+	FVector LastAimTraceStart = FVector::ZeroVector;
+	FVector LastAimTraceDirection = FVector::ZeroVector;
+	double LastAimTraceTime = -1.0;
+	/** Distance along the camera ray of the last aim hit, AimMaxRange if it hit nothing */
+	float AimHitDistance = 0.0f;
+	
+	//-------------------------------------------
+	void Death();
+	virtual void Destroyed() override;
+	UFUNCTION(BlueprintImplementableEvent)
+	void DestroyEffect_BP();
+	bool isDead=false;
+	UPROPERTY(BlueprintReadWrite)
+	bool b_CanAim=true;
+};
+
+
+
+
+
+	
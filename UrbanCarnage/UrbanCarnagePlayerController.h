@@ -1,69 +1,75 @@
-// Copyright Epic Games, Inc. All Rights Reserved.
-
-#pragma once
-
-#include "CoreMinimal.h"
-#include "GameFramework/PlayerController.h"
-#include "UrbanCarnagePlayerController.generated.h"
-
-class UInputMappingContext;
-class AUrbanCarnagePawn;
-class UUrbanCarnageUI;
-
-/**
- *  Vehicle Player Controller class
- *  Handles input mapping and user interface
- */
-UCLASS(abstract)
-class URBANCARNAGE_API AUrbanCarnagePlayerController : public APlayerController
-{
-	GENERATED_BODY()
-
-protected:
-
-	/** Input Mapping Context to be used for player input */
-	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = Input)
-	UInputMappingContext* InputMappingContext;
-
-	/** If true, the optional steering wheel input mapping context will be registered */
-	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = Input)
-	bool bUseSteeringWheelControls = false;
-
-	/** Optional Input Mapping Context to be used for steering wheel input.
-	 *  This is added alongside the default Input Mapping Context and does not block other forms of input.
-	 */
-	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = Input, meta=(EditCondition="bUseSteeringWheelControls"))
-	UInputMappingContext* SteeringWheelInputMappingContext;
-
-	/** Pointer to the controlled vehicle pawn */
-	TObjectPtr<AUrbanCarnagePawn> VehiclePawn;
-
-	/** Type of the UI to spawn */
-	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = UI)
-	TSubclassOf<UUrbanCarnageUI> VehicleUIClass;
-
-	/** Pointer to the UI widget */
-	TObjectPtr<UUrbanCarnageUI> VehicleUI;
-
-	
-
-	// Begin Actor interface
-protected:
-
-	virtual void BeginPlay() override;
-	virtual void SetupInputComponent() override;
-
-public:
-
-	virtual void Tick(float Delta) override;
-	UFUNCTION(BlueprintCallable)
-	void setupContext(){SetupInputComponent();}
-	// End Actor interface
-
-	// Begin PlayerController interface
-protected:
-
-	virtual void OnPossess(APawn* InPawn) override;
-
-	// End PlayerController interface
-};
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "GameFramework/PlayerController.h"
+#include "UrbanCarnageNetTypes.h"
+#include "UrbanCarnagePlayerController.generated.h"
+
+class UInputMappingContext;
+class AUrbanCarnagePawn;
+class UUrbanCarnageUI;
+
+/**
+ *  Vehicle Player Controller class
+ *  Handles input mapping and user interface
+ */
+UCLASS(abstract)
+class URBANCARNAGE_API AUrbanCarnagePlayerController : public APlayerController
+{
+	GENERATED_BODY()
+
+protected:
+
+	/** Input Mapping Context to be used for player input */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = Input)
+	UInputMappingContext* InputMappingContext;
+
+	/** If true, the optional steering wheel input mapping context will be registered */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = Input)
+	bool bUseSteeringWheelControls = false;
+
+	/** Optional Input Mapping Context to be used for steering wheel input.
+	 *  This is added alongside the default Input Mapping Context and does not block other forms of input.
+	 */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = Input, meta=(EditCondition="bUseSteeringWheelControls"))
+	UInputMappingContext* SteeringWheelInputMappingContext;
+
+	/** Pointer to the controlled vehicle pawn */
+	TObjectPtr<AUrbanCarnagePawn> VehiclePawn;
+
+	/** Type of the UI to spawn */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = UI)
+	TSubclassOf<UUrbanCarnageUI> VehicleUIClass;
+
+	/** Pointer to the UI widget */
+	TObjectPtr<UUrbanCarnageUI> VehicleUI;
+
+	
+
+	// Begin Actor interface
+protected:
+
+	virtual void BeginPlay() override;
+	virtual void SetupInputComponent() override;
+
+public:
+
+	virtual void Tick(float Delta) override;
+	UFUNCTION(BlueprintCallable)
+	void setupContext(){SetupInputComponent();}
+	// End Actor interface
+
+	// Begin PlayerController interface
+protected:
+
+	virtual void OnPossess(APawn* InPawn) override;
+
+	// End PlayerController interface
+
+public:
+	/** Cosmetic events batched for this player by UCosmeticEventSubsystem */
+	UFUNCTION(Client, Unreliable)
+	void Client_CosmeticEvents(const TArray<FCosmeticEvent>& Events);
+};
@@ -0,0 +1,231 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "UrbanCarnageReplicationGraph.h"
+#include "UrbanCarnagePawn.h"
+#include "WeaponBase.h"
+#include "Core/BulletBase.h"
+#include "Engine/LevelScriptActor.h"
+#include "Engine/NetConnection.h"
+#include "GameFramework/Info.h"
+#include "GameFramework/PlayerController.h"
+#include "UObject/UObjectIterator.h"
+
+DEFINE_LOG_CATEGORY_STATIC(LogUrbanCarnageRepGraph, Log, All);
+
+UUrbanCarnageReplicationGraph::UUrbanCarnageReplicationGraph()
+{
+}
+
+void UUrbanCarnageReplicationGraph::InitClassReplicationInfo(FClassReplicationInfo& Info, UClass* Class, bool bSpatialized) const
+{
+	const AActor* CDO = Class->GetDefaultObject<AActor>();
+	if (bSpatialized)
+	{
+		Info.SetCullDistanceSquared(CDO->GetNetCullDistanceSquared());
+	}
+	Info.ReplicationPeriodFrame = GetReplicationPeriodFrameForFrequency(CDO->GetNetUpdateFrequency());
+}
+
+EClassRepNodeMapping UUrbanCarnageReplicationGraph::GetMappingPolicy(UClass* Class)
+{
+	if (const EClassRepNodeMapping* Policy = ClassRepNodePolicies.Get(Class))
+	{
+		return *Policy;
+	}
+	return EClassRepNodeMapping::NotRouted;
+}
+
+void UUrbanCarnageReplicationGraph::InitGlobalActorClassSettings()
+{
+	Super::InitGlobalActorClassSettings();
+
+	// explicit routing for our own classes and the engine ones that need it
+	ClassRepNodePolicies.Set(AUrbanCarnagePawn::StaticClass(), EClassRepNodeMapping::Spatialize_Dynamic);
+	ClassRepNodePolicies.Set(ABulletBase::StaticClass(), EClassRepNodeMapping::Spatialize_Dynamic);
+	// weapons ride along with their owning vehicle as dependent actors
+	ClassRepNodePolicies.Set(AWeaponBase::StaticClass(), EClassRepNodeMapping::NotRouted);
+	// controllers are added by the per connection node
+	ClassRepNodePolicies.Set(APlayerController::StaticClass(), EClassRepNodeMapping::NotRouted);
+	ClassRepNodePolicies.Set(ALevelScriptActor::StaticClass(), EClassRepNodeMapping::NotRouted);
+	ClassRepNodePolicies.Set(AInfo::StaticClass(), EClassRepNodeMapping::RelevantAllConnections);
+
+	// derive a policy for every other replicated class from its defaults
+	for (TObjectIterator<UClass> It; It; ++It)
+	{
+		UClass* Class = *It;
+		AActor* ActorCDO = Cast<AActor>(Class->GetDefaultObject());
+		if (!ActorCDO || !ActorCDO->GetIsReplicated())
+		{
+			continue;
+		}
+		// skip blueprint skeleton and reinstanced classes
+		if (Class->GetName().StartsWith(TEXT("SKEL_")) || Class->GetName().StartsWith(TEXT("REINST_")))
+		{
+			continue;
+		}
+
+		EClassRepNodeMapping Policy;
+		if (const EClassRepNodeMapping* ExistingPolicy = ClassRepNodePolicies.Get(Class))
+		{
+			Policy = *ExistingPolicy;
+		}
+		else
+		{
+			if (ActorCDO->bAlwaysRelevant)
+			{
+				Policy = EClassRepNodeMapping::RelevantAllConnections;
+			}
+			else if (ActorCDO->bOnlyRelevantToOwner)
+			{
+				Policy = EClassRepNodeMapping::NotRouted;
+			}
+			else if (ActorCDO->IsReplicatingMovement())
+			{
+				Policy = EClassRepNodeMapping::Spatialize_Dynamic;
+			}
+			else
+			{
+				Policy = EClassRepNodeMapping::Spatialize_Dormancy;
+			}
+			ClassRepNodePolicies.Set(Class, Policy);
+		}
+
+		const bool bSpatialized = Policy == EClassRepNodeMapping::Spatialize_Static
+			|| Policy == EClassRepNodeMapping::Spatialize_Dynamic
+			|| Policy == EClassRepNodeMapping::Spatialize_Dormancy;
+
+		FClassReplicationInfo ClassInfo;
+		InitClassReplicationInfo(ClassInfo, Class, bSpatialized);
+		if (Class->IsChildOf(AUrbanCarnagePawn::StaticClass()))
+		{
+			ClassInfo.SetCullDistanceSquared(FMath::Square(VehicleCullDistance));
+		}
+		else if (Class->IsChildOf(ABulletBase::StaticClass()))
+		{
+			ClassInfo.SetCullDistanceSquared(FMath::Square(ProjectileCullDistance));
+		}
+		GlobalActorReplicationInfoMap.SetClassInfo(Class, ClassInfo);
+	}
+}
+
+void UUrbanCarnageReplicationGraph::InitGlobalGraphNodes()
+{
+	GridNode = CreateNewNode<UReplicationGraphNode_GridSpatialization2D>();
+	GridNode->CellSize = GridCellSize;
+	GridNode->SpatialBias = FVector2D(SpatialBiasX, SpatialBiasY);
+	if (bDisableSpatialRebuilds)
+	{
+		GridNode->AddToClassRebuildDenyList(AActor::StaticClass());
+	}
+	AddGlobalGraphNode(GridNode);
+
+	AlwaysRelevantNode = CreateNewNode<UReplicationGraphNode_ActorList>();
+	AddGlobalGraphNode(AlwaysRelevantNode);
+}
+
+void UUrbanCarnageReplicationGraph::InitConnectionGraphNodes(UNetReplicationGraphConnection* RepGraphConnection)
+{
+	Super::InitConnectionGraphNodes(RepGraphConnection);
+
+	UUrbanCarnageReplicationGraphNode_AlwaysRelevant_ForConnection* AlwaysRelevantConnectionNode = CreateNewNode<UUrbanCarnageReplicationGraphNode_AlwaysRelevant_ForConnection>();
+	AddConnectionGraphNode(AlwaysRelevantConnectionNode, RepGraphConnection);
+}
+
+void UUrbanCarnageReplicationGraph::RouteAddNetworkActorToNodes(const FNewReplicatedActorInfo& ActorInfo, FGlobalActorReplicationInfo& GlobalInfo)
+{
+	switch (GetMappingPolicy(ActorInfo.Class))
+	{
+	case EClassRepNodeMapping::RelevantAllConnections:
+		AlwaysRelevantNode->NotifyAddNetworkActor(ActorInfo);
+		break;
+	case EClassRepNodeMapping::Spatialize_Static:
+		GridNode->AddActor_Static(ActorInfo, GlobalInfo);
+		break;
+	case EClassRepNodeMapping::Spatialize_Dynamic:
+		GridNode->AddActor_Dynamic(ActorInfo, GlobalInfo);
+		break;
+	case EClassRepNodeMapping::Spatialize_Dormancy:
+		GridNode->AddActor_Dormancy(ActorInfo, GlobalInfo);
+		break;
+	default:
+		break;
+	}
+
+	if (AWeaponBase* Weapon = Cast<AWeaponBase>(ActorInfo.Actor))
+	{
+		if (AActor* WeaponOwner = Weapon->GetOwner())
+		{
+			GlobalActorReplicationInfoMap.AddDependentActor(WeaponOwner, Weapon);
+		}
+		else
+		{
+			UE_LOG(LogUrbanCarnageRepGraph, Warning, TEXT("Weapon %s has no owner when added to the replication graph, it will not replicate"), *GetNameSafe(Weapon));
+		}
+	}
+}
+
+void UUrbanCarnageReplicationGraph::RouteRemoveNetworkActorToNodes(const FNewReplicatedActorInfo& ActorInfo)
+{
+	switch (GetMappingPolicy(ActorInfo.Class))
+	{
+	case EClassRepNodeMapping::RelevantAllConnections:
+		AlwaysRelevantNode->NotifyRemoveNetworkActor(ActorInfo);
+		break;
+	case EClassRepNodeMapping::Spatialize_Static:
+		GridNode->RemoveActor_Static(ActorInfo);
+		break;
+	case EClassRepNodeMapping::Spatialize_Dynamic:
+		GridNode->RemoveActor_Dynamic(ActorInfo);
+		break;
+	case EClassRepNodeMapping::Spatialize_Dormancy:
+		GridNode->RemoveActor_Dormancy(ActorInfo);
+		break;
+	default:
+		break;
+	}
+
+	if (AWeaponBase* Weapon = Cast<AWeaponBase>(ActorInfo.Actor))
+	{
+		if (AActor* WeaponOwner = Weapon->GetOwner())
+		{
+			GlobalActorReplicationInfoMap.RemoveDependentActor(WeaponOwner, Weapon);
+		}
+	}
+}
+
+void UUrbanCarnageReplicationGraph::SetVehicleUpdateFrequency(AActor* Vehicle, float Frequency)
+{
+	// the class settings are copied per actor and per connection when the actor is added, update both
+	if (FGlobalActorReplicationInfo* GlobalInfo = GlobalActorReplicationInfoMap.Find(Vehicle))
+	{
+		GlobalInfo->Settings.ReplicationPeriodFrame = GetReplicationPeriodFrameForFrequency(Frequency);
+	}
+	const FVector VehicleLocation = Vehicle->GetActorLocation();
+	const uint16 NearPeriod = GetReplicationPeriodFrameForFrequency(Frequency);
+	const uint16 FarPeriod = GetReplicationPeriodFrameForFrequency(Frequency * VehicleFarUpdateScale);
+	for (UNetReplicationGraphConnection* Connection : Connections)
+	{
+		FConnectionReplicationActorInfo* ActorInfo = Connection->ActorInfoMap.Find(Vehicle);
+		if (!ActorInfo) continue;
+		const AActor* ViewTarget = Connection->NetConnection ? Connection->NetConnection->ViewTarget.Get() : nullptr;
+		const bool bFar = ViewTarget && FVector::DistSquared(ViewTarget->GetActorLocation(), VehicleLocation) > FMath::Square(VehicleFarUpdateDistance);
+		ActorInfo->ReplicationPeriodFrame = bFar ? FarPeriod : NearPeriod;
+	}
+}
+
+void UUrbanCarnageReplicationGraphNode_AlwaysRelevant_ForConnection::GatherActorListsForConnection(const FConnectionGatherActorListParameters& Params)
+{
+	ReplicationActorList.Reset();
+	for (const FNetViewer& Viewer : Params.Viewers)
+	{
+		ReplicationActorList.ConditionalAdd(Viewer.InViewer);
+		ReplicationActorList.ConditionalAdd(Viewer.ViewTarget);
+		if (const APlayerController* PC = Cast<APlayerController>(Viewer.InViewer))
+		{
+			// our own vehicle stays relevant even outside the grid cull distance, its weapons follow as dependents
+			ReplicationActorList.ConditionalAdd(PC->GetPawn());
+		}
+	}
+	Super::GatherActorListsForConnection(Params);
+}
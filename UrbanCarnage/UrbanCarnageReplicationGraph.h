@@ -0,0 +1,102 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "ReplicationGraph.h"
+#include "UrbanCarnageReplicationGraph.generated.h"
+
+class UReplicationGraphNode_GridSpatialization2D;
+class UReplicationGraphNode_ActorList;
+
+/** How actors of a class are routed into the replication graph */
+enum class EClassRepNodeMapping : uint32
+{
+	NotRouted,				// Not routed to a node, replicated through another path (dependents, per connection node)
+	RelevantAllConnections,	// Always relevant to every connection
+	Spatialize_Static,		// Spatialized, never moves
+	Spatialize_Dynamic,		// Spatialized, updated every frame
+	Spatialize_Dormancy,	// Spatialized, treated as static while dormant and dynamic while awake
+};
+
+/**
+ *  Replication graph for Urban Carnage
+ *  Vehicles and projectiles are routed into a 2D spatial grid, weapons replicate as dependents
+ *  of their owning vehicle and projectiles use a short cull distance.
+ *
+ *  Enabled from DefaultEngine.ini:
+ *  [/Script/OnlineSubsystemUtils.IpNetDriver]
+ *  ReplicationDriverClassName="/Script/UrbanCarnage.UrbanCarnageReplicationGraph"
+ */
+UCLASS(transient, config=Engine)
+class URBANCARNAGE_API UUrbanCarnageReplicationGraph : public UReplicationGraph
+{
+	GENERATED_BODY()
+
+public:
+	UUrbanCarnageReplicationGraph();
+
+	// Begin UReplicationGraph interface
+	virtual void InitGlobalActorClassSettings() override;
+	virtual void InitGlobalGraphNodes() override;
+	virtual void InitConnectionGraphNodes(UNetReplicationGraphConnection* RepGraphConnection) override;
+	virtual void RouteAddNetworkActorToNodes(const FNewReplicatedActorInfo& ActorInfo, FGlobalActorReplicationInfo& GlobalInfo) override;
+	virtual void RouteRemoveNetworkActorToNodes(const FNewReplicatedActorInfo& ActorInfo) override;
+	// End UReplicationGraph interface
+
+	/** Sets the update rate of a vehicle, lowered per connection for far away viewers */
+	void SetVehicleUpdateFrequency(AActor* Vehicle, float Frequency);
+
+	/** Size of a grid cell, in cm */
+	UPROPERTY(Config)
+	float GridCellSize = 10000.0f;
+
+	/** Lowest X/Y of the playable area, actors below it are clamped into the first cell */
+	UPROPERTY(Config)
+	float SpatialBiasX = -200000.0f;
+	UPROPERTY(Config)
+	float SpatialBiasY = -200000.0f;
+
+	/** Cull distance for vehicles, in cm */
+	UPROPERTY(Config)
+	float VehicleCullDistance = 50000.0f;
+
+	/** Connections viewing a vehicle from further than this get its updates at VehicleFarUpdateScale of the rate */
+	UPROPERTY(Config)
+	float VehicleFarUpdateDistance = 20000.0f;
+	UPROPERTY(Config)
+	float VehicleFarUpdateScale = 0.5f;
+
+	/** Cull distance for projectiles, in cm */
+	UPROPERTY(Config)
+	float ProjectileCullDistance = 8000.0f;
+
+	/** If true, actors that leave the grid bounds do not force a grid rebuild */
+	UPROPERTY(Config)
+	bool bDisableSpatialRebuilds = true;
+
+	UPROPERTY()
+	TObjectPtr<UReplicationGraphNode_GridSpatialization2D> GridNode;
+
+	UPROPERTY()
+	TObjectPtr<UReplicationGraphNode_ActorList> AlwaysRelevantNode;
+
+protected:
+	EClassRepNodeMapping GetMappingPolicy(UClass* Class);
+	void InitClassReplicationInfo(FClassReplicationInfo& Info, UClass* Class, bool bSpatialized) const;
+
+	TClassMap<EClassRepNodeMapping> ClassRepNodePolicies;
+};
+
+/**
+ *  Per connection node, keeps the connection's own controller, view target and vehicle relevant
+ *  regardless of the spatial grid.
+ */
+UCLASS()
+class URBANCARNAGE_API UUrbanCarnageReplicationGraphNode_AlwaysRelevant_ForConnection : public UReplicationGraphNode_AlwaysRelevant_ForConnection
+{
+	GENERATED_BODY()
+
+public:
+	virtual void GatherActorListsForConnection(const FConnectionGatherActorListParameters& Params) override;
+};
@@ -1,20 +1,20 @@
-// Copyright Epic Games, Inc. All Rights Reserved.
-
-#pragma once
-
-#include "CoreMinimal.h"
-#include "UrbanCarnagePawn.h"
-#include "UrbanCarnageSportsCar.generated.h"
-
-/**
- *  Sports car wheeled vehicle implementation
- */
-UCLASS(abstract)
-class URBANCARNAGE_API AUrbanCarnageSportsCar : public AUrbanCarnagePawn
-{
-	GENERATED_BODY()
-	
-public:
-
-	AUrbanCarnageSportsCar();
-};
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "UrbanCarnagePawn.h"
+#include "UrbanCarnageSportsCar.generated.h"
+
+/**
+ *  Sports car wheeled vehicle implementation
+ */
+UCLASS(abstract)
+class URBANCARNAGE_API AUrbanCarnageSportsCar : public AUrbanCarnagePawn
+{
+	GENERATED_BODY()
+	
+public:
+
+	AUrbanCarnageSportsCar();
+};
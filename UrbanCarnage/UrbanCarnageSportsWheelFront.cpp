@@ -1,14 +1,14 @@
-// Copyright Epic Games, Inc. All Rights Reserved.
-
-
-#include "UrbanCarnageSportsWheelFront.h"
-
-UUrbanCarnageSportsWheelFront::UUrbanCarnageSportsWheelFront()
-{
-	WheelRadius = 39.0f;
-	WheelWidth = 35.0f;
-	FrictionForceMultiplier = 3.0f;
-
-	MaxBrakeTorque = 4500.0f;
-	MaxHandBrakeTorque = 6000.0f;
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+
+#include "UrbanCarnageSportsWheelFront.h"
+
+UUrbanCarnageSportsWheelFront::UUrbanCarnageSportsWheelFront()
+{
+	WheelRadius = 39.0f;
+	WheelWidth = 35.0f;
+	FrictionForceMultiplier = 3.0f;
+
+	MaxBrakeTorque = 4500.0f;
+	MaxHandBrakeTorque = 6000.0f;
 }
\ No newline at end of file
@@ -1,20 +1,20 @@
-// Copyright Epic Games, Inc. All Rights Reserved.
-
-#pragma once
-
-#include "CoreMinimal.h"
-#include "UrbanCarnageWheelFront.h"
-#include "UrbanCarnageSportsWheelFront.generated.h"
-
-/**
- *  Front wheel definition for Sports Car.
- */
-UCLASS()
-class URBANCARNAGE_API UUrbanCarnageSportsWheelFront : public UUrbanCarnageWheelFront
-{
-	GENERATED_BODY()
-	
-public:
-
-	UUrbanCarnageSportsWheelFront();
-};
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "UrbanCarnageWheelFront.h"
+#include "UrbanCarnageSportsWheelFront.generated.h"
+
+/**
+ *  Front wheel definition for Sports Car.
+ */
+UCLASS()
+class URBANCARNAGE_API UUrbanCarnageSportsWheelFront : public UUrbanCarnageWheelFront
+{
+	GENERATED_BODY()
+	
+public:
+
+	UUrbanCarnageSportsWheelFront();
+};
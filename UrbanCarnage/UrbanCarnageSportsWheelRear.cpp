@@ -1,15 +1,15 @@
-// Copyright Epic Games, Inc. All Rights Reserved.
-
-
-#include "UrbanCarnageSportsWheelRear.h"
-
-UUrbanCarnageSportsWheelRear::UUrbanCarnageSportsWheelRear()
-{
-	WheelRadius = 40.f;
-	WheelWidth = 40.0f;
-	FrictionForceMultiplier = 4.0f;
-	SlipThreshold = 100.0f;
-	SkidThreshold = 100.0f;
-	MaxSteerAngle = 0.0f;
-	MaxHandBrakeTorque = 6000.0f;
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+
+#include "UrbanCarnageSportsWheelRear.h"
+
+UUrbanCarnageSportsWheelRear::UUrbanCarnageSportsWheelRear()
+{
+	WheelRadius = 40.f;
+	WheelWidth = 40.0f;
+	FrictionForceMultiplier = 4.0f;
+	SlipThreshold = 100.0f;
+	SkidThreshold = 100.0f;
+	MaxSteerAngle = 0.0f;
+	MaxHandBrakeTorque = 6000.0f;
 }
\ No newline at end of file
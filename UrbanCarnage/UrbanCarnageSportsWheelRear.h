@@ -1,20 +1,20 @@
-// Copyright Epic Games, Inc. All Rights Reserved.
-
-#pragma once
-
-#include "CoreMinimal.h"
-#include "UrbanCarnageWheelRear.h"
-#include "UrbanCarnageSportsWheelRear.generated.h"
-
-/**
- *  Rear wheel definition for Sports Car.
- */
-UCLASS()
-class URBANCARNAGE_API UUrbanCarnageSportsWheelRear : public UUrbanCarnageWheelRear
-{
-	GENERATED_BODY()
-	
-public:
-
-	UUrbanCarnageSportsWheelRear();
-};
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "UrbanCarnageWheelRear.h"
+#include "UrbanCarnageSportsWheelRear.generated.h"
+
+/**
+ *  Rear wheel definition for Sports Car.
+ */
+UCLASS()
+class URBANCARNAGE_API UUrbanCarnageSportsWheelRear : public UUrbanCarnageWheelRear
+{
+	GENERATED_BODY()
+	
+public:
+
+	UUrbanCarnageSportsWheelRear();
+};
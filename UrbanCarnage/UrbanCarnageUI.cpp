@@ -1,19 +1,19 @@
-// Copyright Epic Games, Inc. All Rights Reserved.
-
-
-#include "UrbanCarnageUI.h"
-
-void UUrbanCarnageUI::UpdateSpeed(float NewSpeed)
-{
-	// format the speed to KPH or MPH
-	float FormattedSpeed = FMath::Abs(NewSpeed) * (bIsMPH ? 0.022f : 0.036f);
-
-	// call the Blueprint handler
-	OnSpeedUpdate(FormattedSpeed);
-}
-
-void UUrbanCarnageUI::UpdateGear(int32 NewGear)
-{
-	// call the Blueprint handler
-	OnGearUpdate(NewGear);
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+
+#include "UrbanCarnageUI.h"
+
+void UUrbanCarnageUI::UpdateSpeed(float NewSpeed)
+{
+	// format the speed to KPH or MPH
+	float FormattedSpeed = FMath::Abs(NewSpeed) * (bIsMPH ? 0.022f : 0.036f);
+
+	// call the Blueprint handler
+	OnSpeedUpdate(FormattedSpeed);
+}
+
+void UUrbanCarnageUI::UpdateGear(int32 NewGear)
+{
+	// call the Blueprint handler
+	OnGearUpdate(NewGear);
 }
\ No newline at end of file
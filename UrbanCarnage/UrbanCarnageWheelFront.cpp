@@ -1,11 +1,11 @@
-// Copyright Epic Games, Inc. All Rights Reserved.
-
-#include "UrbanCarnageWheelFront.h"
-#include "UObject/ConstructorHelpers.h"
-
-UUrbanCarnageWheelFront::UUrbanCarnageWheelFront()
-{
-	AxleType = EAxleType::Front;
-	bAffectedBySteering = true;
-	MaxSteerAngle = 40.f;
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "UrbanCarnageWheelFront.h"
+#include "UObject/ConstructorHelpers.h"
+
+UUrbanCarnageWheelFront::UUrbanCarnageWheelFront()
+{
+	AxleType = EAxleType::Front;
+	bAffectedBySteering = true;
+	MaxSteerAngle = 40.f;
 }
\ No newline at end of file
@@ -1,19 +1,19 @@
-// Copyright Epic Games, Inc. All Rights Reserved.
-
-#pragma once
-
-#include "CoreMinimal.h"
-#include "ChaosVehicleWheel.h"
-#include "UrbanCarnageWheelFront.generated.h"
-
-/**
- *  Base front wheel definition.
- */
-UCLASS()
-class UUrbanCarnageWheelFront : public UChaosVehicleWheel
-{
-	GENERATED_BODY()
-
-public:
-	UUrbanCarnageWheelFront();
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "ChaosVehicleWheel.h"
+#include "UrbanCarnageWheelFront.generated.h"
+
+/**
+ *  Base front wheel definition.
+ */
+UCLASS()
+class UUrbanCarnageWheelFront : public UChaosVehicleWheel
+{
+	GENERATED_BODY()
+
+public:
+	UUrbanCarnageWheelFront();
 };
\ No newline at end of file
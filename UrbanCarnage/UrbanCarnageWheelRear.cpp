@@ -1,11 +1,11 @@
-// Copyright Epic Games, Inc. All Rights Reserved.
-
-#include "UrbanCarnageWheelRear.h"
-#include "UObject/ConstructorHelpers.h"
-
-UUrbanCarnageWheelRear::UUrbanCarnageWheelRear()
-{
-	AxleType = EAxleType::Rear;
-	bAffectedByHandbrake = true;
-	bAffectedByEngine = true;
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "UrbanCarnageWheelRear.h"
+#include "UObject/ConstructorHelpers.h"
+
+UUrbanCarnageWheelRear::UUrbanCarnageWheelRear()
+{
+	AxleType = EAxleType::Rear;
+	bAffectedByHandbrake = true;
+	bAffectedByEngine = true;
 }
\ No newline at end of file
@@ -1,19 +1,19 @@
-// Copyright Epic Games, Inc. All Rights Reserved.
-
-#pragma once
-
-#include "CoreMinimal.h"
-#include "ChaosVehicleWheel.h"
-#include "UrbanCarnageWheelRear.generated.h"
-
-/**
- *  Base rear wheel definition.
- */
-UCLASS()
-class UUrbanCarnageWheelRear : public UChaosVehicleWheel
-{
-	GENERATED_BODY()
-
-public:
-	UUrbanCarnageWheelRear();
-};
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "ChaosVehicleWheel.h"
+#include "UrbanCarnageWheelRear.generated.h"
+
+/**
+ *  Base rear wheel definition.
+ */
+UCLASS()
+class UUrbanCarnageWheelRear : public UChaosVehicleWheel
+{
+	GENERATED_BODY()
+
+public:
+	UUrbanCarnageWheelRear();
+};
@@ -0,0 +1,381 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "VehicleTickSubsystem.h"
+#include "UrbanCarnagePawn.h"
+#include "WeaponBase.h"
+#include "ChaosWheeledVehicleMovementComponent.h"
+#include "Components/SkeletalMeshComponent.h"
+#include "AirControlSimCallback.h"
+#include "GroundQuerySubsystem.h"
+#include "Physics/Experimental/PhysScene_Chaos.h"
+#include "PBDRigidsSolver.h"
+#include "SignificanceManager.h"
+#include "Engine/LocalPlayer.h"
+#include "GameFramework/PlayerController.h"
+#include "HAL/IConsoleManager.h"
+#include "ProfilingDebugging/CpuProfilerTrace.h"
+
+DECLARE_STATS_GROUP(TEXT("VehicleTick"), STATGROUP_VehicleTick, STATCAT_Advanced);
+DECLARE_CYCLE_STAT(TEXT("Vehicle Tick"), STAT_VehicleTick, STATGROUP_VehicleTick);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Vehicles"), STAT_VehicleTickVehicles, STATGROUP_VehicleTick);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Airborne Vehicles"), STAT_VehicleTickAirborne, STATGROUP_VehicleTick);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Damping Changes"), STAT_VehicleTickDampingChanges, STATGROUP_VehicleTick);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Gliding Vehicles"), STAT_VehicleTickGliding, STATGROUP_VehicleTick);
+
+static const FName VehicleSignificanceTag(TEXT("Vehicle"));
+
+static TAutoConsoleVariable<float> CVarVehicleLODFullDistance(
+	TEXT("UrbanCarnage.VehicleLOD.FullDistance"),
+	15000.0f,
+	TEXT("Vehicles closer to a local camera than this run the full simulation."));
+
+static TAutoConsoleVariable<float> CVarVehicleLODReducedDistance(
+	TEXT("UrbanCarnage.VehicleLOD.ReducedDistance"),
+	50000.0f,
+	TEXT("Vehicles closer to a local camera than this run the reduced simulation, farther ones are kinematic."));
+
+static TAutoConsoleVariable<float> CVarVehicleLODHysteresis(
+	TEXT("UrbanCarnage.VehicleLOD.Hysteresis"),
+	0.1f,
+	TEXT("Fraction added to a LOD distance before a vehicle that is inside it drops to the next LOD."));
+
+static TAutoConsoleVariable<float> CVarVehicleLODMinTime(
+	TEXT("UrbanCarnage.VehicleLOD.MinTime"),
+	1.0f,
+	TEXT("Seconds a vehicle stays in a simulation LOD before it may switch again."));
+
+static TAutoConsoleVariable<float> CVarVehicleLODNotRenderedTime(
+	TEXT("UrbanCarnage.VehicleLOD.NotRenderedTime"),
+	2.0f,
+	TEXT("Seconds a vehicle outside the full simulation distance has to be out of view before it goes kinematic."));
+
+bool UVehicleTickSubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+	return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+void UVehicleTickSubsystem::OnWorldBeginPlay(UWorld& InWorld)
+{
+	Super::OnWorldBeginPlay(InWorld);
+	bUseSimulationLOD = InWorld.GetNetMode() != NM_DedicatedServer && USignificanceManager::Get(&InWorld) != nullptr;
+	if (InWorld.GetNetMode() == NM_Client) return;
+	FPhysScene* PhysScene = InWorld.GetPhysicsScene();
+	if (Chaos::FPhysicsSolver* Solver = PhysScene ? PhysScene->GetSolver() : nullptr)
+	{
+		AirControlCallback = Solver->CreateAndRegisterSimCallbackObject_External<FAirControlSimCallback>();
+	}
+}
+
+void UVehicleTickSubsystem::Deinitialize()
+{
+	if (AirControlCallback)
+	{
+		FPhysScene* PhysScene = GetWorld()->GetPhysicsScene();
+		if (Chaos::FPhysicsSolver* Solver = PhysScene ? PhysScene->GetSolver() : nullptr)
+		{
+			Solver->UnregisterAndFreeSimCallbackObject_External(AirControlCallback);
+		}
+		AirControlCallback = nullptr;
+	}
+	Vehicles.Empty();
+	Meshes.Empty();
+	Movements.Empty();
+	Flags.Empty();
+	Super::Deinitialize();
+}
+
+TStatId UVehicleTickSubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UVehicleTickSubsystem, STATGROUP_VehicleTick);
+}
+
+void UVehicleTickSubsystem::RegisterVehicle(AUrbanCarnagePawn* Vehicle)
+{
+	if (!Vehicle || Vehicles.Contains(Vehicle)) return;
+	Vehicles.Add(Vehicle);
+	Meshes.Add(Vehicle->GetMesh());
+	Movements.Add(Vehicle->GetChaosVehicleMovement());
+	Flags.Add(0);
+	Vehicle->SetActorTickEnabled(false);
+
+	if (bUseSimulationLOD && !Vehicle->IsLocallyControlled())
+	{
+		USignificanceManager* SignificanceManager = USignificanceManager::Get(GetWorld());
+		SignificanceManager->RegisterObject(Vehicle, VehicleSignificanceTag,
+			[](USignificanceManager::FManagedObjectInfo* Info, const FTransform& Viewpoint)
+			{
+				return CalculateSignificance(CastChecked<AUrbanCarnagePawn>(Info->GetObject()), Viewpoint);
+			},
+			USignificanceManager::EPostSignificanceType::Sequential,
+			[](USignificanceManager::FManagedObjectInfo* Info, float OldSignificance, float Significance, bool bFinal)
+			{
+				// the final call comes from unregistering a vehicle that is going away, leave its physics alone
+				if (bFinal) return;
+				// significance is 2 for Full, 1 for Reduced and 0 for Kinematic
+				const EVehicleSimLOD LOD = Significance >= 2.0f ? EVehicleSimLOD::Full : Significance >= 1.0f ? EVehicleSimLOD::Reduced : EVehicleSimLOD::Kinematic;
+				CastChecked<AUrbanCarnagePawn>(Info->GetObject())->RequestSimulationLOD(LOD);
+			});
+	}
+}
+
+void UVehicleTickSubsystem::UnregisterVehicle(AUrbanCarnagePawn* Vehicle)
+{
+	const int32 Index = Vehicles.IndexOfByKey(Vehicle);
+	if (Index != INDEX_NONE)
+	{
+		RemoveVehicle(Index);
+	}
+	if (USignificanceManager* SignificanceManager = bUseSimulationLOD ? USignificanceManager::Get(GetWorld()) : nullptr)
+	{
+		SignificanceManager->UnregisterObject(Vehicle);
+	}
+}
+
+void UVehicleTickSubsystem::RemoveVehicle(int32 Index)
+{
+	Vehicles.RemoveAtSwap(Index, 1, EAllowShrinking::No);
+	Meshes.RemoveAtSwap(Index, 1, EAllowShrinking::No);
+	Movements.RemoveAtSwap(Index, 1, EAllowShrinking::No);
+	Flags.RemoveAtSwap(Index, 1, EAllowShrinking::No);
+}
+
+void UVehicleTickSubsystem::Tick(float DeltaTime)
+{
+	TRACE_CPUPROFILER_EVENT_SCOPE(UVehicleTickSubsystem::Tick);
+	SCOPE_CYCLE_COUNTER(STAT_VehicleTick);
+
+	GatherState();
+	SET_DWORD_STAT(STAT_VehicleTickVehicles, Vehicles.Num());
+	SET_DWORD_STAT(STAT_VehicleTickAirborne, AirborneIndices.Num());
+
+	// same order as the old per actor tick, but step by step over all vehicles
+	UpdateAngularDamping();
+	{
+		TRACE_CPUPROFILER_EVENT_SCOPE(UVehicleTickSubsystem::FlushInput);
+		for (const int32 Index : LocalIndices)
+		{
+			Vehicles[Index]->FlushVehicleInput();
+		}
+	}
+	UpdateGlide(DeltaTime);
+	UpdateReplicatedMovement(DeltaTime);
+	UpdateAirborne();
+	UpdateAim(DeltaTime);
+	UpdateWeapons(DeltaTime);
+	if (bUseSimulationLOD)
+	{
+		UpdateSignificance();
+		ApplySimulationLODs();
+	}
+}
+
+void UVehicleTickSubsystem::GatherState()
+{
+	TRACE_CPUPROFILER_EVENT_SCOPE(UVehicleTickSubsystem::GatherState);
+	AirborneIndices.Reset();
+	LocalIndices.Reset();
+	AuthorityIndices.Reset();
+	ProxyIndices.Reset();
+	GlideIndices.Reset();
+
+	for (int32 Index = Vehicles.Num() - 1; Index >= 0; --Index)
+	{
+		AUrbanCarnagePawn* Vehicle = Vehicles[Index].Get();
+		if (!IsValid(Vehicle) || !Meshes[Index] || !Movements[Index])
+		{
+			RemoveVehicle(Index);
+		}
+	}
+
+	for (int32 Index = 0; Index < Vehicles.Num(); ++Index)
+	{
+		const AUrbanCarnagePawn* Vehicle = Vehicles[Index].Get();
+		uint8 VehicleFlags = 0;
+		if (Vehicle->HasAuthority()) VehicleFlags |= Flag_Authority;
+		if (Vehicle->IsLocallyControlled()) VehicleFlags |= Flag_LocallyControlled;
+		if (Vehicle->bIsInAir) VehicleFlags |= Flag_InAir;
+		if (Movements[Index]->IsMovingOnGround()) VehicleFlags |= Flag_MovingOnGround;
+		if (Vehicle->GetLocalRole() == ROLE_SimulatedProxy) VehicleFlags |= Flag_SimulatedProxy;
+		if (Vehicle->IsKinematicGlide()) VehicleFlags |= Flag_Gliding;
+		Flags[Index] = VehicleFlags;
+
+		if ((VehicleFlags & Flag_LocallyControlled) != 0) LocalIndices.Add(Index);
+		if ((VehicleFlags & (Flag_Authority | Flag_InAir)) == (Flag_Authority | Flag_InAir)) AirborneIndices.Add(Index);
+		if ((VehicleFlags & Flag_Authority) != 0) AuthorityIndices.Add(Index);
+		if ((VehicleFlags & Flag_SimulatedProxy) != 0) ProxyIndices.Add(Index);
+		// simulated proxies follow the snapshots, also while gliding
+		if ((VehicleFlags & (Flag_Gliding | Flag_SimulatedProxy)) == Flag_Gliding) GlideIndices.Add(Index);
+	}
+}
+
+void UVehicleTickSubsystem::UpdateAngularDamping()
+{
+	TRACE_CPUPROFILER_EVENT_SCOPE(UVehicleTickSubsystem::UpdateAngularDamping);
+	// some angular damping while in midair, only written to the physics body when it changes
+	for (int32 Index = 0; Index < Vehicles.Num(); ++Index)
+	{
+		const float TargetDamping = (Flags[Index] & Flag_MovingOnGround) != 0 ? 0.0f : 3.0f;
+		UPrimitiveComponent* Mesh = Meshes[Index];
+		if (Mesh->GetAngularDamping() != TargetDamping)
+		{
+			Mesh->SetAngularDamping(TargetDamping);
+			INC_DWORD_STAT(STAT_VehicleTickDampingChanges);
+		}
+	}
+}
+
+void UVehicleTickSubsystem::UpdateGlide(float DeltaTime)
+{
+	TRACE_CPUPROFILER_EVENT_SCOPE(UVehicleTickSubsystem::UpdateGlide);
+	SET_DWORD_STAT(STAT_VehicleTickGliding, GlideIndices.Num());
+	for (const int32 Index : GlideIndices)
+	{
+		Vehicles[Index]->UpdateKinematicGlide(DeltaTime);
+	}
+}
+
+void UVehicleTickSubsystem::UpdateReplicatedMovement(float DeltaTime)
+{
+	TRACE_CPUPROFILER_EVENT_SCOPE(UVehicleTickSubsystem::UpdateReplicatedMovement);
+	for (const int32 Index : ProxyIndices)
+	{
+		Vehicles[Index]->UpdateSnapshotInterpolation(DeltaTime);
+	}
+	if (GetWorld()->GetNetMode() == NM_Standalone) return;
+	for (const int32 Index : AuthorityIndices)
+	{
+		Vehicles[Index]->UpdateSnapshotRate();
+	}
+}
+
+void UVehicleTickSubsystem::UpdateAirborne()
+{
+	TRACE_CPUPROFILER_EVENT_SCOPE(UVehicleTickSubsystem::UpdateAirborne);
+	// the forces themselves are applied on the physics thread, only the state goes across
+	if (AirControlCallback)
+	{
+		FAirControlAsyncInput* Input = AirControlCallback->GetProducerInputData_External();
+		Input->Vehicles.Reset(AirborneIndices.Num());
+		for (const int32 Index : AirborneIndices)
+		{
+			// gliding vehicles have no physics body to push
+			if ((Flags[Index] & Flag_Gliding) != 0) continue;
+			const AUrbanCarnagePawn* Vehicle = Vehicles[Index].Get();
+			const FBodyInstance* Body = Meshes[Index]->GetBodyInstance();
+			FAirControlVehicleState& State = Input->Vehicles.AddDefaulted_GetRef();
+			State.Proxy = Body ? Body->GetPhysicsActorHandle() : nullptr;
+			State.SpeedMultiplier = Vehicle->AirSpeedMultiplier;
+			State.TurnMultiplier = Vehicle->AirTurnMultipler;
+			State.bParachuting = Vehicle->IsParachuting;
+		}
+	}
+	if (UGroundQuerySubsystem* GroundQuery = GetWorld()->GetSubsystem<UGroundQuerySubsystem>())
+	{
+		TArray<AUrbanCarnagePawn*, TInlineAllocator<64>> AirborneVehicles;
+		for (const int32 Index : AirborneIndices)
+		{
+			AirborneVehicles.Add(Vehicles[Index].Get());
+		}
+		GroundQuery->Update(AirborneVehicles);
+	}
+}
+
+void UVehicleTickSubsystem::UpdateAim(float DeltaTime)
+{
+	TRACE_CPUPROFILER_EVENT_SCOPE(UVehicleTickSubsystem::UpdateAim);
+	for (const int32 Index : LocalIndices)
+	{
+		AUrbanCarnagePawn* Vehicle = Vehicles[Index].Get();
+		Vehicle->CalculateAimLocation();
+		// shots whose acks never arrive are rolled back even while the vehicle stops firing
+		if ((Flags[Index] & Flag_Authority) == 0 && Vehicle->UnackedShots.Num() > 0)
+		{
+			Vehicle->ExpireUnackedShots();
+		}
+	}
+	for (const int32 Index : AuthorityIndices)
+	{
+		AUrbanCarnagePawn* Vehicle = Vehicles[Index].Get();
+		if (Vehicle->bUseQuantizedAimStream)
+		{
+			Vehicle->UpdateServerAim(DeltaTime);
+		}
+		// all shots of this frame go out in one bunch
+		Vehicle->FlushShotEvents();
+	}
+}
+
+void UVehicleTickSubsystem::UpdateWeapons(float DeltaTime)
+{
+	TRACE_CPUPROFILER_EVENT_SCOPE(UVehicleTickSubsystem::UpdateWeapons);
+	// only simulated proxies interpolate the replicated weapon aim
+	for (const int32 Index : ProxyIndices)
+	{
+		const AUrbanCarnagePawn* Vehicle = Vehicles[Index].Get();
+		for (int32 Slot = 0; Slot < 3; ++Slot)
+		{
+			if (AWeaponBase* Weapon = Vehicle->GetWeaponInSlot(Slot))
+			{
+				Weapon->UpdateAimInterpolation(DeltaTime);
+			}
+		}
+	}
+}
+
+void UVehicleTickSubsystem::UpdateSignificance()
+{
+	TRACE_CPUPROFILER_EVENT_SCOPE(UVehicleTickSubsystem::UpdateSignificance);
+	TArray<FTransform, TInlineAllocator<4>> Viewpoints;
+	for (FConstPlayerControllerIterator It = GetWorld()->GetPlayerControllerIterator(); It; ++It)
+	{
+		const APlayerController* PlayerController = It->Get();
+		if (!PlayerController || !PlayerController->IsLocalController()) continue;
+		FVector ViewLocation;
+		FRotator ViewRotation;
+		PlayerController->GetPlayerViewPoint(ViewLocation, ViewRotation);
+		Viewpoints.Emplace(ViewRotation, ViewLocation);
+	}
+	if (Viewpoints.Num() > 0)
+	{
+		USignificanceManager::Get(GetWorld())->Update(Viewpoints);
+	}
+}
+
+void UVehicleTickSubsystem::ApplySimulationLODs()
+{
+	const double Now = GetWorld()->GetTimeSeconds();
+	const float MinTime = CVarVehicleLODMinTime.GetValueOnGameThread();
+	for (const TWeakObjectPtr<AUrbanCarnagePawn>& VehiclePtr : Vehicles)
+	{
+		AUrbanCarnagePawn* Vehicle = VehiclePtr.Get();
+		if (Vehicle->GetRequestedSimulationLOD() != Vehicle->GetSimulationLOD() && Now - Vehicle->GetSimulationLODChangeTime() >= MinTime)
+		{
+			Vehicle->SetSimulationLOD(Vehicle->GetRequestedSimulationLOD());
+		}
+		Vehicle->UpdateWeaponCopiesSuspension();
+	}
+}
+
+float UVehicleTickSubsystem::CalculateSignificance(const AUrbanCarnagePawn* Vehicle, const FTransform& Viewpoint)
+{
+	const float DistanceSquared = FVector::DistSquared(Vehicle->GetActorLocation(), Viewpoint.GetLocation());
+	const EVehicleSimLOD CurrentLOD = Vehicle->GetSimulationLOD();
+	const float Hysteresis = 1.0f + FMath::Max(0.0f, CVarVehicleLODHysteresis.GetValueOnGameThread());
+	const float FullDistance = CVarVehicleLODFullDistance.GetValueOnGameThread() * (CurrentLOD == EVehicleSimLOD::Full ? Hysteresis : 1.0f);
+	const float ReducedDistance = CVarVehicleLODReducedDistance.GetValueOnGameThread() * (CurrentLOD != EVehicleSimLOD::Kinematic ? Hysteresis : 1.0f);
+	if (DistanceSquared < FMath::Square(FullDistance))
+	{
+		return 2.0f;
+	}
+	if (DistanceSquared > FMath::Square(ReducedDistance))
+	{
+		return 0.0f;
+	}
+	// out of view for a while (behind the camera, occluded or hidden), a glance away keeps the simulation
+	if (!Vehicle->WasRecentlyRendered(CVarVehicleLODNotRenderedTime.GetValueOnGameThread()))
+	{
+		return 0.0f;
+	}
+	return 1.0f;
+}
@@ -0,0 +1,97 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "VehicleTickSubsystem.generated.h"
+
+class AUrbanCarnagePawn;
+class UPrimitiveComponent;
+class UChaosWheeledVehicleMovementComponent;
+class FAirControlSimCallback;
+
+/**
+ *  Ticks all vehicles and their weapons in one place
+ *  Registered vehicles and weapons have their actor tick turned off. Every frame the subsystem refreshes
+ *  a packed copy of the per vehicle state and then runs each step of the vehicle update as its own loop
+ *  over all vehicles that need it.
+ *  On clients and listen servers it also picks every vehicle's simulation LOD through the significance
+ *  manager, based on the distance to the local cameras.
+ */
+UCLASS()
+class URBANCARNAGE_API UVehicleTickSubsystem : public UTickableWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	// Begin USubsystem interface
+	virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+	virtual void OnWorldBeginPlay(UWorld& InWorld) override;
+	virtual void Deinitialize() override;
+	// End USubsystem interface
+
+	// Begin FTickableGameObject interface
+	virtual void Tick(float DeltaTime) override;
+	virtual TStatId GetStatId() const override;
+	// End FTickableGameObject interface
+
+	/** Takes over the tick of Vehicle and its weapons */
+	void RegisterVehicle(AUrbanCarnagePawn* Vehicle);
+	void UnregisterVehicle(AUrbanCarnagePawn* Vehicle);
+
+	int32 GetNumVehicles() const { return Vehicles.Num(); }
+
+protected:
+	void RemoveVehicle(int32 Index);
+	/** Refreshes the per frame flags and the step index lists */
+	void GatherState();
+	void UpdateAngularDamping();
+	/** Moves the vehicles in the kinematic deploy glide */
+	void UpdateGlide(float DeltaTime);
+	/** Interpolates simulated proxies along their snapshots and adapts the server send rates */
+	void UpdateReplicatedMovement(float DeltaTime);
+	/** Hands the air control state to the physics thread and runs the ground queries */
+	void UpdateAirborne();
+	void UpdateAim(float DeltaTime);
+	void UpdateWeapons(float DeltaTime);
+	/** Feeds the local cameras to the significance manager, which picks each vehicle's simulation LOD */
+	void UpdateSignificance();
+	/** Applies the requested simulation LODs of vehicles that held their current one for the minimum time, and suspends the weapons of long kinematic ones */
+	void ApplySimulationLODs();
+
+	/**
+	 * Significance of a vehicle seen from Viewpoint, the EVehicleSimLOD it should run at, inverted.
+	 * A vehicle leaves a closer LOD only past the distance plus the hysteresis margin.
+	 */
+	static float CalculateSignificance(const AUrbanCarnagePawn* Vehicle, const FTransform& Viewpoint);
+
+	// one entry per registered vehicle, all arrays share the same index
+	TArray<TWeakObjectPtr<AUrbanCarnagePawn>> Vehicles;
+	TArray<UPrimitiveComponent*> Meshes;
+	TArray<UChaosWheeledVehicleMovementComponent*> Movements;
+	TArray<uint8> Flags;
+
+	enum EVehicleFlags : uint8
+	{
+		Flag_Authority = 1 << 0,
+		Flag_LocallyControlled = 1 << 1,
+		Flag_InAir = 1 << 2,
+		Flag_MovingOnGround = 1 << 3,
+		Flag_SimulatedProxy = 1 << 4,
+		Flag_Gliding = 1 << 5,
+	};
+
+	// rebuilt every frame, indices into the arrays above
+	TArray<int32> AirborneIndices;
+	TArray<int32> LocalIndices;
+	TArray<int32> AuthorityIndices;
+	TArray<int32> ProxyIndices;
+	TArray<int32> GlideIndices;
+
+	/** True if vehicle LOD is driven from the local cameras (clients and listen servers) */
+	bool bUseSimulationLOD = false;
+
+	/** Physics thread air control for deployed vehicles, server only */
+	FAirControlSimCallback* AirControlCallback = nullptr;
+};
@@ -0,0 +1,131 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "VehicleWeaponsComponent.h"
+#include "WeaponBase.h"
+#include "UrbanCarnagePawn.h"
+#include "Engine/World.h"
+#include "Net/UnrealNetwork.h"
+#include "Net/Core/PushModel/PushModel.h"
+
+UVehicleWeaponsComponent::UVehicleWeaponsComponent()
+{
+	PrimaryComponentTick.bCanEverTick = false;
+	SetIsReplicatedByDefault(true);
+}
+
+void UVehicleWeaponsComponent::GetLifetimeReplicatedProps(TArray<FLifetimeProperty>& OutLifetimeProps) const
+{
+	Super::GetLifetimeReplicatedProps(OutLifetimeProps);
+	FDoRepLifetimeParams Params;
+	Params.bIsPushBased = true;
+	DOREPLIFETIME_WITH_PARAMS_FAST(UVehicleWeaponsComponent, WeaponClasses, Params);
+	// the server aims from the aim RPCs and the owning client from its own AimPoint
+	FDoRepLifetimeParams SimulatedOnlyParams;
+	SimulatedOnlyParams.bIsPushBased = true;
+	SimulatedOnlyParams.Condition = COND_SimulatedOnly;
+	DOREPLIFETIME_WITH_PARAMS_FAST(UVehicleWeaponsComponent, WeaponAims, SimulatedOnlyParams);
+}
+
+void UVehicleWeaponsComponent::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+	// the copies are ours on every machine, nobody else cleans them up
+	for (TObjectPtr<AWeaponBase>& Weapon : Weapons)
+	{
+		if (Weapon)
+		{
+			Weapon->Destroy();
+			Weapon = nullptr;
+		}
+	}
+	Super::EndPlay(EndPlayReason);
+}
+
+AWeaponBase* UVehicleWeaponsComponent::SetWeapon(int32 Slot, TSubclassOf<AWeaponBase> WeaponClass)
+{
+	if (!GetOwner()->HasAuthority() || Slot < 0 || Slot >= NumSlots) return nullptr;
+	WeaponClasses[Slot] = WeaponClass;
+	MARK_PROPERTY_DIRTY_FROM_NAME_STATIC_ARRAY_INDEX(UVehicleWeaponsComponent, WeaponClasses, Slot, this);
+	SyncWeapon(Slot);
+	return Weapons[Slot];
+}
+
+AWeaponBase* UVehicleWeaponsComponent::GetWeapon(int32 Slot) const
+{
+	return Slot >= 0 && Slot < NumSlots ? Weapons[Slot].Get() : nullptr;
+}
+
+void UVehicleWeaponsComponent::SetReplicatedAim(int32 Slot, const FCompressedWeaponAim& Aim)
+{
+	if (Slot < 0 || Slot >= NumSlots) return;
+	WeaponAims[Slot] = Aim;
+	MARK_PROPERTY_DIRTY_FROM_NAME_STATIC_ARRAY_INDEX(UVehicleWeaponsComponent, WeaponAims, Slot, this);
+}
+
+void UVehicleWeaponsComponent::SetLocalCopiesSuspended(bool bSuspend)
+{
+	if (GetOwner()->HasAuthority() || bSuspend == bLocalCopiesSuspended) return;
+	bLocalCopiesSuspended = bSuspend;
+	for (int32 Slot = 0; Slot < NumSlots; ++Slot)
+	{
+		SyncWeapon(Slot);
+	}
+}
+
+void UVehicleWeaponsComponent::OnRep_WeaponClasses()
+{
+	for (int32 Slot = 0; Slot < NumSlots; ++Slot)
+	{
+		SyncWeapon(Slot);
+	}
+}
+
+void UVehicleWeaponsComponent::OnRep_WeaponAims()
+{
+	for (int32 Slot = 0; Slot < NumSlots; ++Slot)
+	{
+		AWeaponBase* Weapon = Weapons[Slot];
+		if (!Weapon) continue;
+		const FCompressedWeaponAim& Aim = WeaponAims[Slot];
+		// the array arrives as a whole, only feed the slots that got a new sample
+		if (Aim.Timestamp == Weapon->CompressedAim.Timestamp && Aim.HasSameAngles(Weapon->CompressedAim)) continue;
+		Weapon->CompressedAim = Aim;
+		Weapon->OnRep_CompressedAim();
+	}
+}
+
+void UVehicleWeaponsComponent::SyncWeapon(int32 Slot)
+{
+	AUrbanCarnagePawn* Vehicle = GetOwner<AUrbanCarnagePawn>();
+	if (!Vehicle) return;
+	TObjectPtr<AWeaponBase>& Weapon = Weapons[Slot];
+	const TSubclassOf<AWeaponBase> WeaponClass = bLocalCopiesSuspended ? nullptr : WeaponClasses[Slot];
+	if (Weapon && Weapon->GetClass() == WeaponClass) return;
+	if (Weapon)
+	{
+		Weapon->Destroy();
+		Weapon = nullptr;
+	}
+
+	USceneComponent* SlotComponent = Vehicle->GetWeaponSlotComponent(Slot);
+	if (WeaponClass && SlotComponent)
+	{
+		const FTransform SpawnTransform = SlotComponent->GetComponentTransform();
+		Weapon = GetWorld()->SpawnActorDeferred<AWeaponBase>(WeaponClass, SpawnTransform, Vehicle, nullptr, ESpawnActorCollisionHandlingMethod::AlwaysSpawn);
+		if (Weapon)
+		{
+			// every machine spawns its own copy, only the vehicle replicates
+			Weapon->SetReplicates(false);
+			Weapon->WeaponsComponent = this;
+			Weapon->FinishSpawning(SpawnTransform);
+			Weapon->AttachToComponent(SlotComponent, FAttachmentTransformRules::SnapToTargetNotIncludingScale);
+			// a copy spawned after a suspension picks up the aim it missed
+			if (!Vehicle->HasAuthority() && WeaponAims[Slot].Timestamp != 0)
+			{
+				Weapon->CompressedAim = WeaponAims[Slot];
+				Weapon->OnRep_CompressedAim();
+			}
+		}
+	}
+	Vehicle->SetWeaponInSlot(Slot, Weapon);
+}
@@ -0,0 +1,68 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Components/ActorComponent.h"
+#include "UrbanCarnageNetTypes.h"
+#include "VehicleWeaponsComponent.generated.h"
+
+class AWeaponBase;
+
+/**
+ *  Replicates the weapons of a vehicle through the vehicle's own actor channel
+ *  Every machine spawns its own, non replicated copy of each AWeaponBase from the replicated weapon classes,
+ *  so weapons have no actor channel and no relevancy of their own. The component carries the only
+ *  replicated weapon state, the class and the compressed aim of each slot. Shoot, Aim and the fire path
+ *  run on the local copies as before, weapons ask HasWeaponAuthority() instead of HasAuthority().
+ *  Clients only keep copies for vehicles they simulate, a vehicle in the Kinematic simulation LOD has none
+ *  until it comes back or fires.
+ */
+UCLASS(ClassGroup = (UrbanCarnage))
+class URBANCARNAGE_API UVehicleWeaponsComponent : public UActorComponent
+{
+	GENERATED_BODY()
+
+public:
+	UVehicleWeaponsComponent();
+
+	// Begin UActorComponent interface
+	virtual void GetLifetimeReplicatedProps(TArray<FLifetimeProperty>& OutLifetimeProps) const override;
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
+	// End UActorComponent interface
+
+	/** Same slots as AUrbanCarnagePawn::GetWeaponInSlot */
+	static constexpr int32 NumSlots = 3;
+
+	/** Server side, equips WeaponClass in Slot, replacing what was there, or empties the slot if null */
+	AWeaponBase* SetWeapon(int32 Slot, TSubclassOf<AWeaponBase> WeaponClass);
+
+	/** Local copy of the weapon in Slot */
+	AWeaponBase* GetWeapon(int32 Slot) const;
+
+	/** Server side, publishes the aim of the weapon in Slot to simulated proxies */
+	void SetReplicatedAim(int32 Slot, const FCompressedWeaponAim& Aim);
+
+	/** Client side, destroys the local copies while suspended and spawns them again from the replicated classes after */
+	void SetLocalCopiesSuspended(bool bSuspend);
+	bool AreLocalCopiesSuspended() const { return bLocalCopiesSuspended; }
+
+protected:
+	UPROPERTY(ReplicatedUsing = OnRep_WeaponClasses)
+	TSubclassOf<AWeaponBase> WeaponClasses[3];
+	UFUNCTION()
+	void OnRep_WeaponClasses();
+
+	UPROPERTY(ReplicatedUsing = OnRep_WeaponAims)
+	FCompressedWeaponAim WeaponAims[3];
+	UFUNCTION()
+	void OnRep_WeaponAims();
+
+	UPROPERTY(Transient)
+	TObjectPtr<AWeaponBase> Weapons[3];
+
+	bool bLocalCopiesSuspended = false;
+
+	/** Spawns or destroys the local copy of Slot to match its replicated class */
+	void SyncWeapon(int32 Slot);
+};
@@ -1,164 +1,462 @@
-// Fill out your copyright notice in the Description page of Project Settings.
-
-
-#include "WeaponBase.h"
-#include "Net/UnrealNetwork.h"
-#include "Components/ArrowComponent.h"
-#include "Components/StaticMeshComponent.h"
-#include "Components/SceneComponent.h"
-#include "GameFramework/ProjectileMovementComponent.h"
-#include "CoreMinimal.h"
-#include "ChaosWheeledVehicleMovementComponent.h"
-#include "UrbanCarnagePawn.h"
-#include "GameFramework/Actor.h"
-#include "TimerManager.h"
-#include "Engine/Engine.h"
-#include "Core/BulletBase.h"
-
-
-// Sets default values
-AWeaponBase::AWeaponBase()
-{
-	//set replicated
-	SetReplicates(true);
-	
-	// Set this actor to call Tick() every frame.  You can turn this off to improve performance if you don't need it.
-	PrimaryActorTick.bCanEverTick = true;
-
-	WeaponBaseRoot = CreateDefaultSubobject<USceneComponent>(TEXT("WeaponBaseRoot"));
-	RootComponent = WeaponBaseRoot;
-	TurretBase = CreateDefaultSubobject<USceneComponent>(TEXT("TurretBase"));
-	TurretBase->SetupAttachment(WeaponBaseRoot);
-	TurretMesh = CreateDefaultSubobject<UStaticMeshComponent>(TEXT("TurretMesh"));
-	TurretMesh->SetupAttachment(TurretBase);
-	CannonBase = CreateDefaultSubobject<USceneComponent>(TEXT("CannonBase"));
-	CannonBase->SetupAttachment(TurretBase);
-	CannonMesh = CreateDefaultSubobject<UStaticMeshComponent>(TEXT("CannonMesh"));
-	CannonMesh->SetupAttachment(CannonBase);
-	Muzzle = CreateDefaultSubobject<UArrowComponent>(TEXT("MuzzleLocation"));
-	Muzzle->SetupAttachment(CannonBase);
-	//set replicate movement to false
-	
-	
-}
-
-void AWeaponBase::GetLifetimeReplicatedProps(TArray<class FLifetimeProperty>& OutLifetimeProps) const
-{
-	Super::GetLifetimeReplicatedProps(OutLifetimeProps);
-	DOREPLIFETIME(AWeaponBase,AimRotationStruct);
-
-	
-}
-
-// Called when the game starts or when spawned
-void AWeaponBase::BeginPlay()
-{
-	Super::BeginPlay();
-	
-	
-}
-
-void AWeaponBase::Aim(FVector _AimPoint)
-{
-	if (!GetOwner())return;
-	//if is locally controlled pawn, return 
-	/*if (GetOwner()->GetLocalRole() == Role)
-	{
-		return;
-	}*/
-	// aim the turret and cannon at the aim point with interpolation
-	FRotator TurretRotation = TurretBase->GetComponentRotation();
-	TurretRotation.Roll=GetOwner()->GetActorRotation().Roll;
-	TurretRotation.Pitch=GetOwner()->GetActorRotation().Pitch;
-	FRotator CannonRotation = CannonBase->GetComponentRotation();
-	CannonRotation.Yaw = TurretRotation.Yaw;
-	CannonRotation.Roll = TurretRotation.Roll;
-	FRotator AimRotationTurret = (_AimPoint - TurretBase->GetComponentLocation()).Rotation();
-	FRotator AimRotationCannon = (_AimPoint - CannonBase->GetComponentLocation()).Rotation();
-	// interpolate the turret rotation in yaw only relative to the car
-	TurretRotation.Yaw = FMath::FInterpTo(TurretRotation.Yaw, AimRotationTurret.Yaw, GetWorld()->GetDeltaSeconds(), WeaponRotationSpeed);
-	TurretBase->SetWorldRotation(TurretRotation);
-	//TurretRotation.Pitch=GetActorRotation().Pitch;
-	//TurretRotation.Roll=GetActorRotation().Roll;
-	
-	TurretBase->SetWorldRotation(TurretRotation);
-	// interpolate the cannon rotation in pitch only relative to the turret
-	CannonRotation.Pitch = FMath::FInterpTo(CannonRotation.Pitch, AimRotationCannon.Pitch, GetWorld()->GetDeltaSeconds(), WeaponRotationSpeed);
-	//CannonRotation.Yaw=TurretRotation.Yaw;
-	//CannonRotation.Roll=TurretRotation.Roll;
-	CannonBase->SetWorldRotation(CannonRotation);
-	// Debug messages to check the rotations
-	
-	AimRotation(TurretRotation, CannonRotation);
-	AimRotationStruct.CannonAimRotation = CannonRotation;
-	AimRotationStruct.TurretAimRotation = TurretRotation;
-	
-	//
-	// if (GEngine)
-	// {
-	// 	GEngine->AddOnScreenDebugMessage(5687, 5.f, FColor::Green, FString::Printf(TEXT("Turret Yaw: %f"), TurretRotation.Yaw));
-	// 	GEngine->AddOnScreenDebugMessage(5688, 5.f, FColor::Green, FString::Printf(TEXT("Cannon Pitch: %f"), CannonRotation.Pitch));
-	// }
-	
-}
-
-void AWeaponBase::AimRotation_Implementation(FRotator TurretRotation, FRotator CannonRotation)
-{
-	//only do this if not locally controlled pawn
-	
-	TurretBase->SetWorldRotation(TurretRotation);
-	CannonBase->SetWorldRotation(CannonRotation);
-}
-
-FWeaponAimRotation AWeaponBase::GetAimRotation()
-{
-	return AimRotationStruct;
-}
-
-void AWeaponBase::Shoot()
-{
-	if (!HasAuthority()) return;
-	if (!bReadyToFire) return;
-    
-	AActor* bullet = GetWorld()->SpawnActor<AActor>(BulletClass, Muzzle->GetComponentLocation(), Muzzle->GetComponentRotation());
-	if (bullet)
-	{
-		// set the owner of the bullet to this pawn
-		bullet->SetOwner(GetOwner());
-		//Set velocity
-		//Cast<ABulletBase>(bullet)->ProjectileMovementComponent->Velocity=bullet->GetActorForwardVector()*72000.f;
-		PlayEffect();
-		// Debug message to check if the bullet is spawned
-		//GEngine->AddOnScreenDebugMessage(5689, 5.f, FColor::Green, FString::Printf(TEXT("Bullet Spawned")));
-		ShotFired();
-	}
-	GetWorld()->GetTimerManager().SetTimer(FireRateTimer, this, &AWeaponBase::SetReadyToFire, (1/FireRate)/FireRateMultiplier, false);
-	//print (1/FireRate)*FireRateMultiplier to screen
-	if (GEngine)
-	{
-		//GEngine->AddOnScreenDebugMessage(5689, 5.f, FColor::Green, FString::Printf(TEXT("FireRate: %f"), (1/FireRate)/FireRateMultiplier));
-	}
-	bReadyToFire = false;
-}
-
-void AWeaponBase::ShotFired_Implementation()
-{
-	ShotFiredEffect();
-}
-
-void AWeaponBase::SetReadyToFire()
-{
-	bReadyToFire = true;
-}
-void AWeaponBase::PlayEffect_Implementation()
-{
-	PlayEffectBP();
-}
-
-// Called every frame
-void AWeaponBase::Tick(float DeltaTime)
-{
-	Super::Tick(DeltaTime);
-	
-}
-
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "WeaponBase.h"
+#include "Net/UnrealNetwork.h"
+#include "Net/Core/PushModel/PushModel.h"
+#include "Components/ArrowComponent.h"
+#include "Components/StaticMeshComponent.h"
+#include "Components/SceneComponent.h"
+#include "GameFramework/ProjectileMovementComponent.h"
+#include "CoreMinimal.h"
+#include "ChaosWheeledVehicleMovementComponent.h"
+#include "UrbanCarnagePawn.h"
+#include "GameFramework/Actor.h"
+#include "Engine/Engine.h"
+#include "Core/BulletBase.h"
+#include "ProjectilePoolSubsystem.h"
+#include "ProjectileSimulationSubsystem.h"
+#include "HitscanBatchSubsystem.h"
+#include "FireSchedulerSubsystem.h"
+#include "AbilitySystemBlueprintLibrary.h"
+#include "AbilitySystemComponent.h"
+#include "GameplayEffect.h"
+#include "CosmeticEventSubsystem.h"
+#include "DamageAggregatorSubsystem.h"
+#include "VehicleWeaponsComponent.h"
+#include "HAL/IConsoleManager.h"
+
+static TAutoConsoleVariable<float> CVarFireMaxPredictedOriginError(
+	TEXT("UrbanCarnage.Fire.MaxPredictedOriginError"),
+	500.0f,
+	TEXT("Furthest a predicted shot may start from the server's muzzle before it is rejected."));
+
+static TAutoConsoleVariable<float> CVarFireMaxPredictedAimError(
+	TEXT("UrbanCarnage.Fire.MaxPredictedAimError"),
+	30.0f,
+	TEXT("Largest angle in degrees between a predicted shot and the server's muzzle before it is rejected."));
+
+
+// Sets default values
+AWeaponBase::AWeaponBase()
+{
+	//set replicated
+	SetReplicates(true);
+	// weapons are relevant exactly when the vehicle carrying them is
+	bNetUseOwnerRelevancy = true;
+	
+	// the vehicle tick subsystem drives the aim interpolation, the weapon itself never ticks
+	PrimaryActorTick.bCanEverTick = false;
+
+	WeaponBaseRoot = CreateDefaultSubobject<USceneComponent>(TEXT("WeaponBaseRoot"));
+	RootComponent = WeaponBaseRoot;
+	TurretBase = CreateDefaultSubobject<USceneComponent>(TEXT("TurretBase"));
+	TurretBase->SetupAttachment(WeaponBaseRoot);
+	TurretMesh = CreateDefaultSubobject<UStaticMeshComponent>(TEXT("TurretMesh"));
+	TurretMesh->SetupAttachment(TurretBase);
+	CannonBase = CreateDefaultSubobject<USceneComponent>(TEXT("CannonBase"));
+	CannonBase->SetupAttachment(TurretBase);
+	CannonMesh = CreateDefaultSubobject<UStaticMeshComponent>(TEXT("CannonMesh"));
+	CannonMesh->SetupAttachment(CannonBase);
+	Muzzle = CreateDefaultSubobject<UArrowComponent>(TEXT("MuzzleLocation"));
+	Muzzle->SetupAttachment(CannonBase);
+	//set replicate movement to false
+	
+	// aim only changes in small steps, simulated proxies interpolate between updates
+	SetNetUpdateFrequency(30.0f);
+	
+}
+
+void AWeaponBase::GetLifetimeReplicatedProps(TArray<class FLifetimeProperty>& OutLifetimeProps) const
+{
+	Super::GetLifetimeReplicatedProps(OutLifetimeProps);
+	FDoRepLifetimeParams Params;
+	Params.bIsPushBased = true;
+	DOREPLIFETIME_WITH_PARAMS_FAST(AWeaponBase,CompressedAim,Params);
+
+	
+}
+
+// Called when the game starts or when spawned
+void AWeaponBase::BeginPlay()
+{
+	Super::BeginPlay();
+	
+	if (HasWeaponAuthority() && bUseProjectilePool && FireMode == EWeaponFireMode::ProjectileActor)
+	{
+		if (UProjectilePoolSubsystem* Pool = GetWorld()->GetSubsystem<UProjectilePoolSubsystem>())
+		{
+			Pool->Prewarm(BulletClass, ProjectilePoolSize, ProjectileLifetime);
+		}
+	}
+}
+
+void AWeaponBase::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+	StopShooting();
+	Super::EndPlay(EndPlayReason);
+}
+
+void AWeaponBase::Aim(FVector _AimPoint)
+{
+	if (!GetOwner())return;
+	//if is locally controlled pawn, return 
+	/*if (GetOwner()->GetLocalRole() == Role)
+	{
+		return;
+	}*/
+	// aim the turret and cannon at the aim point with interpolation
+	FRotator TurretRotation = TurretBase->GetComponentRotation();
+	TurretRotation.Roll=GetOwner()->GetActorRotation().Roll;
+	TurretRotation.Pitch=GetOwner()->GetActorRotation().Pitch;
+	FRotator CannonRotation = CannonBase->GetComponentRotation();
+	CannonRotation.Yaw = TurretRotation.Yaw;
+	CannonRotation.Roll = TurretRotation.Roll;
+	FRotator AimRotationTurret = (_AimPoint - TurretBase->GetComponentLocation()).Rotation();
+	FRotator AimRotationCannon = (_AimPoint - CannonBase->GetComponentLocation()).Rotation();
+	// interpolate the turret rotation in yaw only relative to the car
+	TurretRotation.Yaw = FMath::FInterpTo(TurretRotation.Yaw, AimRotationTurret.Yaw, GetWorld()->GetDeltaSeconds(), WeaponRotationSpeed);
+	TurretBase->SetWorldRotation(TurretRotation);
+	//TurretRotation.Pitch=GetActorRotation().Pitch;
+	//TurretRotation.Roll=GetActorRotation().Roll;
+	
+	TurretBase->SetWorldRotation(TurretRotation);
+	// interpolate the cannon rotation in pitch only relative to the turret
+	CannonRotation.Pitch = FMath::FInterpTo(CannonRotation.Pitch, AimRotationCannon.Pitch, GetWorld()->GetDeltaSeconds(), WeaponRotationSpeed);
+	//CannonRotation.Yaw=TurretRotation.Yaw;
+	//CannonRotation.Roll=TurretRotation.Roll;
+	CannonBase->SetWorldRotation(CannonRotation);
+	// Debug messages to check the rotations
+	
+	AimRotationStruct.CannonAimRotation = CannonRotation;
+	AimRotationStruct.TurretAimRotation = TurretRotation;
+	LastAimFrame = GFrameCounter;
+	if (HasWeaponAuthority())
+	{
+		FCompressedWeaponAim NewAim;
+		NewAim.TurretYaw = FRotator::CompressAxisToShort(TurretRotation.Yaw);
+		NewAim.CannonPitch = FRotator::CompressAxisToShort(CannonRotation.Pitch);
+		// only dirty the property when the quantized angles actually moved
+		if (!NewAim.HasSameAngles(CompressedAim))
+		{
+			NewAim.Timestamp = FCompressedWeaponAim::CompressTime(GetWorld()->GetTimeSeconds());
+			CompressedAim = NewAim;
+			if (WeaponsComponent)
+			{
+				const AUrbanCarnagePawn* Pawn = Cast<AUrbanCarnagePawn>(GetOwner());
+				WeaponsComponent->SetReplicatedAim(Pawn ? Pawn->GetWeaponSlot(this) : INDEX_NONE, NewAim);
+			}
+			else
+			{
+				MARK_PROPERTY_DIRTY_FROM_NAME(AWeaponBase, CompressedAim, this);
+			}
+		}
+	}
+	
+	//
+	// if (GEngine)
+	// {
+	// 	GEngine->AddOnScreenDebugMessage(5687, 5.f, FColor::Green, FString::Printf(TEXT("Turret Yaw: %f"), TurretRotation.Yaw));
+	// 	GEngine->AddOnScreenDebugMessage(5688, 5.f, FColor::Green, FString::Printf(TEXT("Cannon Pitch: %f"), CannonRotation.Pitch));
+	// }
+	
+}
+
+void AWeaponBase::OnRep_CompressedAim()
+{
+	FAimSample Sample;
+	Sample.TurretYaw = CompressedAim.GetTurretYaw();
+	Sample.CannonPitch = CompressedAim.GetCannonPitch();
+	if (AimSamples.Num() == 0)
+	{
+		Sample.Time = 0.0;
+		AimPlaybackTime = -AimInterpolationDelay;
+	}
+	else
+	{
+		// unwrap the 16-bit millisecond timestamp against the previous sample
+		const FAimSample& Last = AimSamples.Last();
+		Sample.Time = Last.Time + CompressedAim.GetDeltaMs(LastReceivedAimTimestamp) / 1000.0;
+	}
+	LastReceivedAimTimestamp = CompressedAim.Timestamp;
+	if (AimSamples.Num() == MaxAimSamples)
+	{
+		AimSamples.RemoveAt(0, 1, EAllowShrinking::No);
+	}
+	AimSamples.Add(Sample);
+}
+
+void AWeaponBase::UpdateAimInterpolation(float DeltaTime)
+{
+	if (AimSamples.Num() == 0) return;
+	const FAimSample& Newest = AimSamples.Last();
+	AimPlaybackTime += DeltaTime;
+	// catch up if we fell too far behind, hold the last pose if the stream stalled
+	AimPlaybackTime = FMath::Clamp(AimPlaybackTime, Newest.Time - AimInterpolationDelay * 3.0, Newest.Time);
+
+	const FAimSample* From = &AimSamples[0];
+	const FAimSample* To = &AimSamples[0];
+	for (const FAimSample& Sample : AimSamples)
+	{
+		To = &Sample;
+		if (Sample.Time >= AimPlaybackTime) break;
+		From = &Sample;
+	}
+	const double Span = To->Time - From->Time;
+	const float Alpha = Span > KINDA_SMALL_NUMBER ? FMath::Clamp((float)((AimPlaybackTime - From->Time) / Span), 0.0f, 1.0f) : 1.0f;
+	const float TurretYaw = From->TurretYaw + FRotator::NormalizeAxis(To->TurretYaw - From->TurretYaw) * Alpha;
+	const float CannonPitch = FMath::Lerp(From->CannonPitch, To->CannonPitch, Alpha);
+	ApplyAimAngles(TurretYaw, CannonPitch);
+}
+
+void AWeaponBase::ApplyAimAngles(float TurretYaw, float CannonPitch)
+{
+	const FRotator OwnerRotation = GetOwner() ? GetOwner()->GetActorRotation() : GetActorRotation();
+	const FRotator TurretRotation(OwnerRotation.Pitch, TurretYaw, OwnerRotation.Roll);
+	const FRotator CannonRotation(CannonPitch, TurretYaw, OwnerRotation.Roll);
+	TurretBase->SetWorldRotation(TurretRotation);
+	CannonBase->SetWorldRotation(CannonRotation);
+	AimRotationStruct.TurretAimRotation = TurretRotation;
+	AimRotationStruct.CannonAimRotation = CannonRotation;
+}
+
+FWeaponAimRotation AWeaponBase::GetAimRotation()
+{
+	return AimRotationStruct;
+}
+
+void AWeaponBase::Shoot()
+{
+	if (!HasWeaponAuthority() && !IsOwnerLocallyControlled()) return;
+	if (UFireSchedulerSubsystem* Scheduler = GetWorld()->GetSubsystem<UFireSchedulerSubsystem>())
+	{
+		Scheduler->RequestFire(this);
+	}
+}
+
+void AWeaponBase::StopShooting()
+{
+	if (UFireSchedulerSubsystem* Scheduler = GetWorld()->GetSubsystem<UFireSchedulerSubsystem>())
+	{
+		Scheduler->ReleaseTrigger(this);
+	}
+}
+
+bool AWeaponBase::FireShot(float Age)
+{
+	if (!HasWeaponAuthority())
+	{
+		return FirePredictedShot();
+	}
+	FShotFiredEvent Shot;
+	return MakeShotEvent(Shot) && FireAuthoritativeShot(Shot, Age);
+}
+
+bool AWeaponBase::FireAuthoritativeShot(const FShotFiredEvent& Shot, float Age)
+{
+	switch (FireMode)
+	{
+	case EWeaponFireMode::SimulatedProjectile:
+		return FireSimulatedProjectile(Shot, Age);
+	case EWeaponFireMode::Hitscan:
+		return FireHitscan(Shot);
+	default:
+		return FireProjectileActor(Shot);
+	}
+}
+
+bool AWeaponBase::MakeShotEvent(FShotFiredEvent& OutShot) const
+{
+	const AUrbanCarnagePawn* Pawn = Cast<AUrbanCarnagePawn>(GetOwner());
+	const int32 Slot = Pawn ? Pawn->GetWeaponSlot(this) : INDEX_NONE;
+	if (Slot == INDEX_NONE) return false;
+	OutShot.Origin = Muzzle->GetComponentLocation();
+	OutShot.Direction = Muzzle->GetForwardVector();
+	OutShot.Seed = (uint16)FMath::RandHelper(MAX_uint16 + 1);
+	OutShot.WeaponSlot = (uint8)Slot;
+	return true;
+}
+
+bool AWeaponBase::FirePredictedShot()
+{
+	AUrbanCarnagePawn* Pawn = Cast<AUrbanCarnagePawn>(GetOwner());
+	FShotFiredEvent Shot;
+	if (!Pawn) return false;
+	// the fire scheduler may tick before the vehicle aimed this frame, the shot leaves where the turret points now
+	if (LastAimFrame != GFrameCounter)
+	{
+		Aim(Pawn->AimPoint);
+	}
+	if (!MakeShotEvent(Shot)) return false;
+	// cosmetic here, the server fires the same shot once it accepts it
+	Pawn->QueuePredictedShot(Shot);
+	SimulateShotFired(Shot);
+	return true;
+}
+
+bool AWeaponBase::ValidatePredictedShot(const FShotFiredEvent& Shot) const
+{
+	// our muzzle trails the client's by the latency of the aim stream, only catch shots from elsewhere
+	const float MaxOriginError = CVarFireMaxPredictedOriginError.GetValueOnGameThread();
+	if (FVector::DistSquared(Shot.Origin, Muzzle->GetComponentLocation()) > FMath::Square(MaxOriginError))
+	{
+		return false;
+	}
+	const float MinCos = FMath::Cos(FMath::DegreesToRadians(CVarFireMaxPredictedAimError.GetValueOnGameThread()));
+	if (FVector::DotProduct(Shot.Direction, Muzzle->GetForwardVector()) >= MinCos)
+	{
+		return true;
+	}
+	// our turret may still be turning towards the aim point the client already reached
+	const AUrbanCarnagePawn* Pawn = Cast<AUrbanCarnagePawn>(GetOwner());
+	const FVector ToAimPoint = Pawn ? (Pawn->AimPoint - Shot.Origin).GetSafeNormal() : FVector::ZeroVector;
+	return !ToAimPoint.IsZero() && FVector::DotProduct(Shot.Direction, ToAimPoint) >= MinCos;
+}
+
+bool AWeaponBase::IsOwnerLocallyControlled() const
+{
+	const APawn* Pawn = Cast<APawn>(GetOwner());
+	return Pawn && Pawn->IsLocallyControlled();
+}
+
+bool AWeaponBase::HasWeaponAuthority() const
+{
+	const AActor* WeaponOwner = GetOwner();
+	return WeaponOwner ? WeaponOwner->HasAuthority() : HasAuthority();
+}
+
+bool AWeaponBase::FireProjectileActor(const FShotFiredEvent& Shot)
+{
+	AActor* bullet = nullptr;
+	const FTransform SpawnTransform(Shot.Direction.Rotation(), Shot.Origin);
+	UProjectilePoolSubsystem* Pool = bUseProjectilePool ? GetWorld()->GetSubsystem<UProjectilePoolSubsystem>() : nullptr;
+	if (Pool)
+	{
+		bullet = Pool->Acquire(BulletClass, SpawnTransform, GetOwner(), ProjectileLifetime);
+	}
+	else
+	{
+		bullet = GetWorld()->SpawnActor<AActor>(BulletClass, SpawnTransform);
+	}
+	if (!bullet) return false;
+
+	// set the owner of the bullet to this pawn
+	bullet->SetOwner(GetOwner());
+	//Set velocity
+	//Cast<ABulletBase>(bullet)->ProjectileMovementComponent->Velocity=bullet->GetActorForwardVector()*72000.f;
+	UCosmeticEventSubsystem::Post(GetOwner(), ECosmeticEventType::WeaponFired, (uint8)Shot.WeaponSlot);
+	// Debug message to check if the bullet is spawned
+	//GEngine->AddOnScreenDebugMessage(5689, 5.f, FColor::Green, FString::Printf(TEXT("Bullet Spawned")));
+	return true;
+}
+
+bool AWeaponBase::FireSimulatedProjectile(const FShotFiredEvent& Shot, float Age)
+{
+	AUrbanCarnagePawn* Pawn = Cast<AUrbanCarnagePawn>(GetOwner());
+	UProjectileSimulationSubsystem* Simulation = GetWorld()->GetSubsystem<UProjectileSimulationSubsystem>();
+	if (!Simulation || !Pawn) return false;
+
+	// spread comes from the seed so clients rebuild the same direction
+	const FVector Direction = GetShotDirection(Shot.Direction, Shot.Seed);
+	Simulation->SpawnProjectile(this, Shot.Origin, Direction, true, Age);
+	Pawn->QueueShotEvent(Shot);
+	if (GetNetMode() != NM_DedicatedServer)
+	{
+		PlayEffectBP();
+		SimulatedShotFiredBP(Shot.Origin, Direction);
+	}
+	return true;
+}
+
+bool AWeaponBase::FireHitscan(const FShotFiredEvent& Shot)
+{
+	AUrbanCarnagePawn* Pawn = Cast<AUrbanCarnagePawn>(GetOwner());
+	UHitscanBatchSubsystem* Hitscan = GetWorld()->GetSubsystem<UHitscanBatchSubsystem>();
+	if (!Hitscan || !Pawn) return false;
+
+	const FVector Direction = GetShotDirection(Shot.Direction, Shot.Seed);
+	Hitscan->QueueShot(this, Shot.Origin, Direction, true);
+	Pawn->QueueShotEvent(Shot);
+	if (GetNetMode() != NM_DedicatedServer)
+	{
+		PlayEffectBP();
+		SimulatedShotFiredBP(Shot.Origin, Direction);
+	}
+	return true;
+}
+
+void AWeaponBase::SimulateShotFired(const FShotFiredEvent& Shot)
+{
+	const FVector Direction = GetShotDirection(Shot.Direction, Shot.Seed);
+	if (FireMode == EWeaponFireMode::Hitscan)
+	{
+		// clients trace too, only to place the impact effect
+		if (UHitscanBatchSubsystem* Hitscan = GetWorld()->GetSubsystem<UHitscanBatchSubsystem>())
+		{
+			Hitscan->QueueShot(this, Shot.Origin, Direction, false);
+		}
+	}
+	else if (FireMode == EWeaponFireMode::SimulatedProjectile)
+	{
+		if (UProjectileSimulationSubsystem* Simulation = GetWorld()->GetSubsystem<UProjectileSimulationSubsystem>())
+		{
+			Simulation->SpawnProjectile(this, Shot.Origin, Direction, false);
+		}
+	}
+	PlayEffectBP();
+	SimulatedShotFiredBP(Shot.Origin, Direction);
+}
+
+FVector AWeaponBase::GetShotDirection(const FVector& Direction, uint16 Seed) const
+{
+	if (SpreadDegrees <= 0.0f) return Direction;
+	const FRandomStream Stream(Seed);
+	return Stream.VRandCone(Direction, FMath::DegreesToRadians(SpreadDegrees));
+}
+
+void AWeaponBase::AddShooterIgnoredActors(FCollisionQueryParams& QueryParams) const
+{
+	QueryParams.AddIgnoredActor(this);
+	QueryParams.AddIgnoredActor(GetOwner());
+	if (const AUrbanCarnagePawn* Vehicle = Cast<AUrbanCarnagePawn>(GetOwner()))
+	{
+		for (int32 Slot = 0; Slot < 3; ++Slot)
+		{
+			if (const AWeaponBase* Weapon = Vehicle->GetWeaponInSlot(Slot))
+			{
+				QueryParams.AddIgnoredActor(Weapon);
+			}
+		}
+	}
+}
+
+void AWeaponBase::ApplyHitDamage(AActor* Target, float Amount)
+{
+	if (!HasWeaponAuthority() || !Target) return;
+	if (UDamageAggregatorSubsystem* DamageAggregator = GetWorld()->GetSubsystem<UDamageAggregatorSubsystem>())
+	{
+		DamageAggregator->AddDamage(Target, this, Amount);
+		return;
+	}
+	ApplyDamageEffect(Target, Amount);
+}
+
+void AWeaponBase::ApplyDamageEffect(AActor* Target, float Amount)
+{
+	if (!HasWeaponAuthority() || !Target || !DamageEffect) return;
+	UAbilitySystemComponent* TargetASC = UAbilitySystemBlueprintLibrary::GetAbilitySystemComponent(Target);
+	if (!TargetASC) return;
+
+	// the vehicle is the instigator so kill credit goes to the driver
+	UAbilitySystemComponent* SourceASC = UAbilitySystemBlueprintLibrary::GetAbilitySystemComponent(GetOwner());
+	UAbilitySystemComponent* SpecASC = SourceASC ? SourceASC : TargetASC;
+	FGameplayEffectContextHandle Context = SpecASC->MakeEffectContext();
+	Context.AddInstigator(GetOwner(), this);
+	FGameplayEffectSpecHandle Spec = SpecASC->MakeOutgoingSpec(DamageEffect, 1.0f, Context);
+	if (!Spec.IsValid()) return;
+	if (DamageSetByCallerTag.IsValid())
+	{
+		Spec.Data->SetSetByCallerMagnitude(DamageSetByCallerTag, Amount);
+	}
+	SpecASC->ApplyGameplayEffectSpecToTarget(*Spec.Data.Get(), TargetASC);
+}
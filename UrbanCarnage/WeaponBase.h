@@ -1,107 +1,242 @@
-// Fill out your copyright notice in the Description page of Project Settings.
-
-#pragma once
-
-#include "CoreMinimal.h"
-#include "InputAction.h"
-#include "GameFramework/Actor.h"
-#include "Components/ArrowComponent.h"
-#include "Core/BulletBase.h"
-#include "WeaponBase.generated.h"
-
-//make a blueprint struct for cannon aim rotation and turret aim rotation
-USTRUCT(BlueprintType)
-struct FWeaponAimRotation
-{
-	GENERATED_BODY()
-	UPROPERTY(EditAnywhere, BlueprintReadWrite)
-	FRotator CannonAimRotation;
-	UPROPERTY(EditAnywhere, BlueprintReadWrite)
-	FRotator TurretAimRotation;
-};
-
-UCLASS()
-class URBANCARNAGE_API AWeaponBase : public AActor
-{
-	GENERATED_BODY()
-
-public:
-	// Sets default values for this actor's properties
-	AWeaponBase();
-	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Weapon")
-	USceneComponent * WeaponBaseRoot;
-	UPROPERTY(EditAnywhere, BlueprintReadWrite , Category = "Weapon")
-	USceneComponent* TurretBase;
-	UPROPERTY(EditAnywhere, BlueprintReadWrite , Category = "Weapon")
-	UStaticMeshComponent* TurretMesh;
-	UPROPERTY(EditAnywhere, BlueprintReadWrite , Category = "Weapon")
-	USceneComponent* CannonBase;
-	UPROPERTY(EditAnywhere, BlueprintReadWrite , Category = "Weapon")
-	UStaticMeshComponent* CannonMesh;
-	UPROPERTY(EditAnywhere, BlueprintReadWrite , Category = "Weapon")
-	UArrowComponent* Muzzle;
-	UPROPERTY(EditAnywhere, BlueprintReadWrite , Category = "Weapon")
-	bool PrimaryWeapon = true;
-	UPROPERTY(EditAnywhere, BlueprintReadWrite , Category = "Weapon")
-	bool SecondaryWeapon = false;
-	UPROPERTY(EditAnywhere, BlueprintReadWrite , Category = "Weapon")
-	bool CanRotate = false;
-	UPROPERTY(EditAnywhere, BlueprintReadWrite , Category = "Weapon")
-	float FireRate = 10.f;
-	UPROPERTY(EditAnywhere, BlueprintReadWrite , Category = "Weapon")
-	float WeaponRotationSpeed=15.0f;
-	UPROPERTY(EditAnywhere, BlueprintReadWrite , Category = "Weapon")
-	float FireRateMultiplier = 1.0f;
-	
-	
-	
-	virtual void GetLifetimeReplicatedProps(TArray<class FLifetimeProperty>& OutLifetimeProps) const override;
-	//virtual void SetupPlayerInputComponent(UInputComponent* InputComponent);
-
-
-protected:
-	// Called when the game starts or when spawned
-	virtual void BeginPlay() override;
-	FTimerHandle FireRateTimer;
-
-	UPROPERTY()
-	bool bReadyToFire=true;
-
-	UFUNCTION()
-	void SetReadyToFire();
-	
-
-public:
-	// Called every frame
-	virtual void Tick(float DeltaTime) override;
-
-	
-
-	UFUNCTION(BlueprintCallable)
-	void Aim(FVector _AimPoint);
-	UFUNCTION(NetMulticast, Unreliable)
-	void AimRotation(FRotator TurretRotation, FRotator CannonRotation);
-	UPROPERTY(Replicated)
-	FWeaponAimRotation AimRotationStruct;
-	UFUNCTION(BlueprintCallable,BlueprintPure)
-	FWeaponAimRotation GetAimRotation();
-	
-	UPROPERTY(EditAnywhere, BlueprintReadWrite , Category = "Default")
-	TSubclassOf<ABulletBase> BulletClass;
-	/*UPROPERTY(EditAnywhere, BlueprintReadWrite , Category = "Vehicle")
-	UInputAction* FireAction;*/
-	UFUNCTION(BlueprintCallable)
-	void Shoot();
-	UFUNCTION(Client,Unreliable)
-	void ShotFired();
-	UFUNCTION(BlueprintImplementableEvent)
-	void ShotFiredEffect();
-
-	UFUNCTION(NetMulticast, Unreliable)
-	void PlayEffect();
-	UFUNCTION(BlueprintImplementableEvent)
-	void PlayEffectBP();
-	
-};
-
- 
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "InputAction.h"
+#include "GameFramework/Actor.h"
+#include "Components/ArrowComponent.h"
+#include "Core/BulletBase.h"
+#include "GameplayTagContainer.h"
+#include "UrbanCarnageNetTypes.h"
+#include "WeaponBase.generated.h"
+
+class UGameplayEffect;
+class UVehicleWeaponsComponent;
+
+/** How a weapon turns a shot into a projectile */
+UENUM(BlueprintType)
+enum class EWeaponFireMode : uint8
+{
+	/** Every shot is a replicated BulletClass actor */
+	ProjectileActor,
+	/** Shots are simulated by the projectile simulation subsystem, only shot events replicate */
+	SimulatedProjectile,
+	/** Shots are instant traces resolved in a batch by the hitscan subsystem, only shot events replicate */
+	Hitscan,
+};
+
+//make a blueprint struct for cannon aim rotation and turret aim rotation
+USTRUCT(BlueprintType)
+struct FWeaponAimRotation
+{
+	GENERATED_BODY()
+	UPROPERTY(EditAnywhere, BlueprintReadWrite)
+	FRotator CannonAimRotation;
+	UPROPERTY(EditAnywhere, BlueprintReadWrite)
+	FRotator TurretAimRotation;
+};
+
+UCLASS()
+class URBANCARNAGE_API AWeaponBase : public AActor
+{
+	GENERATED_BODY()
+
+public:
+	// Sets default values for this actor's properties
+	AWeaponBase();
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Weapon")
+	USceneComponent * WeaponBaseRoot;
+	UPROPERTY(EditAnywhere, BlueprintReadWrite , Category = "Weapon")
+	USceneComponent* TurretBase;
+	UPROPERTY(EditAnywhere, BlueprintReadWrite , Category = "Weapon")
+	UStaticMeshComponent* TurretMesh;
+	UPROPERTY(EditAnywhere, BlueprintReadWrite , Category = "Weapon")
+	USceneComponent* CannonBase;
+	UPROPERTY(EditAnywhere, BlueprintReadWrite , Category = "Weapon")
+	UStaticMeshComponent* CannonMesh;
+	UPROPERTY(EditAnywhere, BlueprintReadWrite , Category = "Weapon")
+	UArrowComponent* Muzzle;
+	UPROPERTY(EditAnywhere, BlueprintReadWrite , Category = "Weapon")
+	bool PrimaryWeapon = true;
+	UPROPERTY(EditAnywhere, BlueprintReadWrite , Category = "Weapon")
+	bool SecondaryWeapon = false;
+	UPROPERTY(EditAnywhere, BlueprintReadWrite , Category = "Weapon")
+	bool CanRotate = false;
+	UPROPERTY(EditAnywhere, BlueprintReadWrite , Category = "Weapon")
+	float FireRate = 10.f;
+	UPROPERTY(EditAnywhere, BlueprintReadWrite , Category = "Weapon")
+	float WeaponRotationSpeed=15.0f;
+	UPROPERTY(EditAnywhere, BlueprintReadWrite , Category = "Weapon")
+	float FireRateMultiplier = 1.0f;
+	
+	
+	
+	virtual void GetLifetimeReplicatedProps(TArray<class FLifetimeProperty>& OutLifetimeProps) const override;
+	//virtual void SetupPlayerInputComponent(UInputComponent* InputComponent);
+
+
+protected:
+	// Called when the game starts or when spawned
+	virtual void BeginPlay() override;
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
+
+	/** Fires one BulletClass actor, returns false if none could be spawned */
+	bool FireProjectileActor(const FShotFiredEvent& Shot);
+	/** Fires one simulated projectile and queues its shot event on the owning vehicle */
+	bool FireSimulatedProjectile(const FShotFiredEvent& Shot, float Age);
+	/** Queues one hitscan shot for the batched trace pass and its shot event on the owning vehicle */
+	bool FireHitscan(const FShotFiredEvent& Shot);
+	/** Owning client side, plays a shot right away and queues it for the server */
+	bool FirePredictedShot();
+	/** Shot leaving the muzzle now with a fresh spread seed, false if the weapon is not on a vehicle */
+	bool MakeShotEvent(FShotFiredEvent& OutShot) const;
+	/** Frame the turret was last aimed in, a predicted shot aims first if it has not been this frame */
+	uint64 LastAimFrame = 0;
+	
+
+public:
+
+	UFUNCTION(BlueprintCallable)
+	void Aim(FVector _AimPoint);
+	/** Current turret and cannon rotation, kept up to date on the server, the owning client and simulated proxies */
+	UPROPERTY()
+	FWeaponAimRotation AimRotationStruct;
+	UFUNCTION(BlueprintCallable,BlueprintPure)
+	FWeaponAimRotation GetAimRotation();
+
+	/** The only replicated representation of the aim, written by Aim when the quantized angles change */
+	UPROPERTY(ReplicatedUsing = OnRep_CompressedAim)
+	FCompressedWeaponAim CompressedAim;
+	UFUNCTION()
+	void OnRep_CompressedAim();
+
+	/** How far behind the newest aim sample simulated proxies render, in seconds */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite , Category = "Weapon")
+	float AimInterpolationDelay = 0.1f;
+
+	/** Advances the simulated proxy aim interpolation, called by the vehicle tick subsystem */
+	void UpdateAimInterpolation(float DeltaTime);
+
+protected:
+	struct FAimSample
+	{
+		double Time;
+		float TurretYaw;
+		float CannonPitch;
+	};
+	static constexpr int32 MaxAimSamples = 4;
+	/** Received aim samples, oldest first, times in unwrapped server seconds */
+	TArray<FAimSample, TInlineAllocator<MaxAimSamples>> AimSamples;
+	double AimPlaybackTime = 0.0;
+	uint16 LastReceivedAimTimestamp = 0;
+
+	/** Rotates turret and cannon to world yaw/pitch, inheriting pitch and roll from the vehicle */
+	void ApplyAimAngles(float TurretYaw, float CannonPitch);
+
+public:
+	
+	UPROPERTY(EditAnywhere, BlueprintReadWrite , Category = "Default")
+	TSubclassOf<ABulletBase> BulletClass;
+	/** If true, bullets come from the world projectile pool instead of being spawned per shot, BulletClass has to release itself on impact */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite , Category = "Default")
+	bool bUseProjectilePool = false;
+	/** Number of bullets this weapon adds to the pool of its BulletClass */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite , Category = "Default", meta = (EditCondition = "bUseProjectilePool"))
+	int32 ProjectilePoolSize = 16;
+	/** Seconds a pooled bullet stays active before it is recycled */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite , Category = "Default", meta = (EditCondition = "bUseProjectilePool"))
+	float ProjectileLifetime = 2.0f;
+	/*UPROPERTY(EditAnywhere, BlueprintReadWrite , Category = "Vehicle")
+	UInputAction* FireAction;*/
+	/** How shots of this weapon are simulated */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite , Category = "Default")
+	EWeaponFireMode FireMode = EWeaponFireMode::ProjectileActor;
+	/** Muzzle speed of simulated projectiles */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite , Category = "Default", meta = (EditCondition = "FireMode == EWeaponFireMode::SimulatedProjectile"))
+	float ProjectileSpeed = 72000.0f;
+	/** Sweep radius of simulated projectiles, 0 uses a line trace */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite , Category = "Default", meta = (EditCondition = "FireMode == EWeaponFireMode::SimulatedProjectile"))
+	float ProjectileRadius = 0.0f;
+	/** Fraction of world gravity applied to simulated projectiles */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite , Category = "Default", meta = (EditCondition = "FireMode == EWeaponFireMode::SimulatedProjectile"))
+	float ProjectileGravityScale = 0.0f;
+	/** Trace length of hitscan shots */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite , Category = "Default", meta = (EditCondition = "FireMode == EWeaponFireMode::Hitscan"))
+	float HitscanRange = 50000.0f;
+	UPROPERTY(EditAnywhere, BlueprintReadWrite , Category = "Default")
+	TEnumAsByte<ECollisionChannel> ProjectileTraceChannel = ECC_Visibility;
+	/** Random spread cone half angle in degrees, rebuilt on clients from the shot seed */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite , Category = "Default")
+	float SpreadDegrees = 0.0f;
+
+	/** Gameplay effect applied to targets hit by our shots when UrbanCarnage.Damage.Aggregate is off, otherwise UDamageAggregatorSubsystem applies its own */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite , Category = "Damage")
+	TSubclassOf<UGameplayEffect> DamageEffect;
+	/** Set by caller tag that receives Damage on the DamageEffect spec */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite , Category = "Damage")
+	FGameplayTag DamageSetByCallerTag;
+	UPROPERTY(EditAnywhere, BlueprintReadWrite , Category = "Damage")
+	float Damage = 10.0f;
+
+	/** Server side, queues damage on a target hit by our shots with UDamageAggregatorSubsystem */
+	void ApplyHitDamage(AActor* Target, float Amount);
+	/** Server side, applies DamageEffect to a target right away, Amount may be the sum of several hits */
+	void ApplyDamageEffect(AActor* Target, float Amount);
+
+	/** Direction of a shot after spread, identical on server and clients for the same seed */
+	FVector GetShotDirection(const FVector& Direction, uint16 Seed) const;
+	/** Ignores the owning vehicle and every weapon in its slots, so shots never hit their own vehicle */
+	void AddShooterIgnoredActors(FCollisionQueryParams& QueryParams) const;
+
+	/** Client side, plays a shot received from the server or predicted by the owning client */
+	void SimulateShotFired(const FShotFiredEvent& Shot);
+
+	/** Server side, fires a shot described by Shot, from the fire scheduler or predicted by the owning client */
+	bool FireAuthoritativeShot(const FShotFiredEvent& Shot, float Age);
+	/**
+	 * Server side, true if a shot predicted by the owning client leaves close to our muzzle and points along
+	 * our muzzle or at the aim point the client sent, the server then fires exactly that shot.
+	 */
+	bool ValidatePredictedShot(const FShotFiredEvent& Shot) const;
+	/** True if the vehicle carrying this weapon is controlled on this machine */
+	bool IsOwnerLocallyControlled() const;
+	/** True on the server, also for the local copies of UVehicleWeaponsComponent which have authority everywhere */
+	bool HasWeaponAuthority() const;
+
+	/** Set if this is a local copy spawned by a vehicle's weapons component, which then replicates the aim */
+	UPROPERTY(Transient)
+	TObjectPtr<UVehicleWeaponsComponent> WeaponsComponent;
+
+	/** Called on the owning client when the server rejected one of its predicted shots */
+	UFUNCTION(BlueprintImplementableEvent)
+	void PredictedShotRejectedBP();
+
+	/** Called when a simulated shot leaves the muzzle, for tracers */
+	UFUNCTION(BlueprintImplementableEvent)
+	void SimulatedShotFiredBP(FVector Origin, FVector Direction);
+	/** Called when a simulated projectile hits something */
+	UFUNCTION(BlueprintImplementableEvent)
+	void SimulatedProjectileImpactBP(FVector Location, FVector Normal);
+
+	/**
+	 * Holds the trigger, the fire scheduler fires at FireRate x FireRateMultiplier while it keeps being called.
+	 * On the server and on the owning client, which predicts its shots.
+	 */
+	UFUNCTION(BlueprintCallable)
+	void Shoot();
+	/** Releases the trigger right away instead of after the hold time */
+	UFUNCTION(BlueprintCallable)
+	void StopShooting();
+	/** Fires a single shot now, called by the fire scheduler. Age is how long ago in this frame the shot was due */
+	bool FireShot(float Age);
+	/** Called on the machine controlling the vehicle once per batch of shots */
+	UFUNCTION(BlueprintImplementableEvent)
+	void ShotFiredEffect();
+
+	UFUNCTION(BlueprintImplementableEvent)
+	void PlayEffectBP();
+	
+};
+
+ 